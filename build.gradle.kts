@@ -29,6 +29,13 @@ application {
     mainClass.set("com.tomtom.sdk.tools.bindingsgenerator.MainKt")
 }
 
+// Read back as GENERATOR_VERSION, which is part of the hash that decides whether outputs are stale
+tasks.jar {
+    manifest {
+        attributes("Implementation-Version" to project.version)
+    }
+}
+
 java {
     toolchain {
         languageVersion.set(JavaLanguageVersion.of(17))
@@ -0,0 +1,113 @@
+package com.tomtom.sdk.tools.bindingsgenerator
+
+import com.google.protobuf.ByteString
+import com.google.protobuf.Descriptors
+import com.google.protobuf.DynamicMessage
+import java.io.File
+import kotlin.random.Random
+
+/**
+ * Size knobs for [CorpusGenerator].
+ *
+ * @param repeatedCount Elements per repeated field. Defaults to 16.
+ * @param repeatedCounts Per-field overrides of [repeatedCount], keyed by field name (`arcs`) or full
+ *   name (`com.example.Route.arcs`). Defaults to empty.
+ * @param stringLength Characters per string value. Defaults to 32.
+ * @param bytesLength Bytes per bytes value. Defaults to 1024.
+ * @param optionalPresence Probability that a proto3 `optional` field is set. Defaults to 1.0.
+ * @param oneofMember Index of the member to set in every oneof, or null to pick one at random by
+ *   [oneofWeights]. Defaults to null.
+ * @param oneofWeights Relative weights of oneof members, keyed by field name (`stop`) or full name
+ *   (`com.example.Route.stop`). Unlisted members weigh 1.0, so an empty map picks uniformly; a oneof whose
+ *   members all weigh 0 is left unset. Defaults to empty.
+ * @param maxDepth Submessage nesting limit, which bounds recursive messages. Defaults to 4.
+ * @param seed Random seed, so the same knobs always produce the same corpus. Defaults to 42.
+ */
+data class CorpusConfig(
+    val repeatedCount: Int = 16,
+    val repeatedCounts: Map<String, Int> = emptyMap(),
+    val stringLength: Int = 32,
+    val bytesLength: Int = 1024,
+    val optionalPresence: Double = 1.0,
+    val oneofMember: Int? = null,
+    val oneofWeights: Map<String, Double> = emptyMap(),
+    val maxDepth: Int = 4,
+    val seed: Int = 42
+)
+
+/**
+ * Builds synthetic messages from a runtime descriptor and writes them as a corpus of
+ * length-delimited records (`writeDelimitedTo`), readable with `parseDelimitedFrom` or
+ * protobuf's `ParseDelimitedFromCodedStream` in C++.
+ */
+class CorpusGenerator(private val config: CorpusConfig = CorpusConfig()) {
+
+    private val random = Random(config.seed)
+
+    fun writeCorpus(descriptor: Descriptors.Descriptor, count: Int, outputFile: File) {
+        outputFile.outputStream().buffered().use { output ->
+            repeat(count) { buildMessage(descriptor).writeDelimitedTo(output) }
+        }
+    }
+
+    fun buildMessage(descriptor: Descriptors.Descriptor, depth: Int = 0): DynamicMessage {
+        val builder = DynamicMessage.newBuilder(descriptor)
+
+        descriptor.realOneofs.forEach { oneof ->
+            val field = oneofMember(oneof) ?: return@forEach
+            sampleValue(field, depth)?.let { builder.setField(field, it) }
+        }
+
+        descriptor.fields.filter { it.realContainingOneof == null }.forEach { field ->
+            when {
+                field.isRepeated -> repeat(repeatedCount(field)) {
+                    sampleValue(field, depth)?.let { builder.addRepeatedField(field, it) }
+                }
+                field.hasOptionalKeyword() && random.nextDouble() >= config.optionalPresence -> Unit
+                else -> sampleValue(field, depth)?.let { builder.setField(field, it) }
+            }
+        }
+
+        return builder.build()
+    }
+
+    /** Returns the member of [oneof] to set, or null when all its members weigh 0. */
+    private fun oneofMember(oneof: Descriptors.OneofDescriptor): Descriptors.FieldDescriptor? {
+        config.oneofMember?.let { return oneof.getField(it.coerceIn(0, oneof.fieldCount - 1)) }
+        if (config.oneofWeights.isEmpty()) return oneof.getField(random.nextInt(oneof.fieldCount))
+
+        val weights = oneof.fields.map { config.oneofWeights[it.fullName] ?: config.oneofWeights[it.name] ?: 1.0 }
+        val total = weights.sum()
+        if (total <= 0.0) return null
+        var remaining = random.nextDouble(total)
+        weights.forEachIndexed { index, weight ->
+            remaining -= weight
+            if (remaining < 0.0) return oneof.getField(index)
+        }
+        return oneof.getField(weights.indexOfLast { it > 0.0 })
+    }
+
+    private fun repeatedCount(field: Descriptors.FieldDescriptor): Int =
+        config.repeatedCounts[field.fullName] ?: config.repeatedCounts[field.name] ?: config.repeatedCount
+
+    /** Returns a value for one element of [field], or null for submessages past [CorpusConfig.maxDepth]. */
+    private fun sampleValue(field: Descriptors.FieldDescriptor, depth: Int): Any? {
+        return when (field.javaType) {
+            Descriptors.FieldDescriptor.JavaType.MESSAGE ->
+                if (depth < config.maxDepth) buildMessage(field.messageType, depth + 1) else null
+            Descriptors.FieldDescriptor.JavaType.ENUM -> field.enumType.values.random(random)
+            Descriptors.FieldDescriptor.JavaType.STRING -> randomString(config.stringLength)
+            Descriptors.FieldDescriptor.JavaType.BYTE_STRING -> ByteString.copyFrom(random.nextBytes(config.bytesLength))
+            Descriptors.FieldDescriptor.JavaType.BOOLEAN -> random.nextBoolean()
+            Descriptors.FieldDescriptor.JavaType.INT -> random.nextInt()
+            Descriptors.FieldDescriptor.JavaType.LONG -> random.nextLong()
+            Descriptors.FieldDescriptor.JavaType.FLOAT -> random.nextFloat()
+            Descriptors.FieldDescriptor.JavaType.DOUBLE -> random.nextDouble()
+        }
+    }
+
+    private fun randomString(length: Int): String {
+        val alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 "
+        return buildString(length) { repeat(length) { append(alphabet[random.nextInt(alphabet.length)]) } }
+    }
+}
@@ -0,0 +1,196 @@
+package com.tomtom.sdk.tools.bindingsgenerator
+
+import java.io.File
+
+/**
+ * Generates a Google Benchmark suite for the conversions emitted by [CppGenerator], plus a CMake
+ * snippet that builds it against the generated helpers.
+ *
+ * Every message gets ToNative, ToProto, round-trip, parse+ToNative and ToProto+serialize benchmarks.
+ * Inputs are filled by generated `Populate` functions that pick a non-default value per field type,
+ * so every field is present on the wire. Recursion into submessages stops after [populateDepth] levels.
+ */
+class CppBenchmarkGenerator(
+    private val config: GeneratorConfig = GeneratorConfig.DEFAULT,
+    private val populateDepth: Int = 3,
+    private val repeatedCount: Int = 8
+) {
+
+    fun generateBenchmark(parsedFile: ParsedProtoFile, headerFile: File, outputFile: File): List<File> {
+        val allMessages = collectAllMessages(parsedFile.messages)
+        val allEnums = collectAllEnums(parsedFile)
+
+        val content = buildString {
+            append(cppCopyrightHeader())
+            appendLine()
+            appendLine("#include \"${headerFile.name}\"")
+            appendLine()
+            appendLine("#include <cstdint>")
+            appendLine("#include <string>")
+            appendLine("#include <utility>")
+            appendLine()
+            appendLine("#include <benchmark/benchmark.h>")
+            appendLine()
+            appendLine("using namespace ${config.namespaces.joinToString("::")};")
+            appendLine()
+            appendLine("namespace {")
+            appendLine()
+            appendLine("constexpr int kPopulateDepth = $populateDepth;")
+            appendLine("constexpr int kRepeatedCount = $repeatedCount;")
+            appendLine()
+
+            allMessages.forEach { appendLine("void Populate(${it.name}* proto, int depth);") }
+            appendLine()
+            allMessages.forEach { appendPopulate(it, allEnums) }
+            allMessages.forEach { appendBenchmarks(it) }
+
+            appendLine("}  // namespace")
+            appendLine()
+            appendLine("BENCHMARK_MAIN();")
+        }
+
+        writeIfChanged(outputFile, content)
+        return listOf(outputFile)
+    }
+
+    /**
+     * Writes a CMake snippet defining the `<name>` executable target. Include it after defining the
+     * library that builds the `*.pb.cc` sources and the native types, and pass that library's name in
+     * `PROTOBUF_HELPERS_PROTO_LIBRARY`.
+     */
+    fun generateCMake(benchmarkFile: File, implementationFile: File, outputFile: File): List<File> {
+        val target = benchmarkFile.nameWithoutExtension
+        val content = buildString {
+            append(lineCommentCopyrightHeader("#"))
+            appendLine()
+            appendLine("find_package(benchmark REQUIRED)")
+            appendLine()
+            appendLine("add_executable($target")
+            appendLine("    \${CMAKE_CURRENT_LIST_DIR}/${implementationFile.name}")
+            appendLine("    \${CMAKE_CURRENT_LIST_DIR}/${benchmarkFile.name}")
+            appendLine(")")
+            appendLine("target_compile_features($target PRIVATE cxx_std_17)")
+            appendLine("target_include_directories($target PRIVATE \${CMAKE_CURRENT_LIST_DIR})")
+            appendLine("target_link_libraries($target PRIVATE \${PROTOBUF_HELPERS_PROTO_LIBRARY} benchmark::benchmark)")
+        }
+
+        writeIfChanged(outputFile, content)
+        return listOf(outputFile)
+    }
+
+    private fun StringBuilder.appendPopulate(message: ParsedMessage, enums: Map<String, ParsedEnum>) {
+        appendLine("void Populate(${message.name}* proto, int depth) {")
+        message.fields.forEach { field ->
+            populateLines(field, enums).forEach { appendLine("    $it") }
+        }
+        // Only the first member of a oneof can be set at a time
+        message.oneofs.forEach { oneof ->
+            oneof.fields.firstOrNull()?.let { field ->
+                populateLines(field, enums).forEach { appendLine("    $it") }
+            }
+        }
+        appendLine("}")
+        appendLine()
+    }
+
+    private fun populateLines(field: ParsedField, enums: Map<String, ParsedEnum>): List<String> {
+        val name = field.protoName
+        if (field.isMessage) {
+            return if (field.isRepeated) {
+                listOf("if (depth > 0) { for (int i = 0; i < kRepeatedCount; ++i) { Populate(proto->add_$name(), depth - 1); } }")
+            } else {
+                listOf("if (depth > 0) { Populate(proto->mutable_$name(), depth - 1); }")
+            }
+        }
+        val value = sampleValue(field, enums) ?: return emptyList()
+        return if (field.isRepeated) {
+            listOf("for (int i = 0; i < kRepeatedCount; ++i) { proto->add_$name($value); }")
+        } else {
+            listOf("proto->set_$name($value);")
+        }
+    }
+
+    /** A value that differs from the proto default, so the field is serialized. */
+    private fun sampleValue(field: ParsedField, enums: Map<String, ParsedEnum>): String? {
+        if (field.isEnum) {
+            val enum = enums[field.typeName.removePrefix(".")] ?: return null
+            val value = enum.values.lastOrNull() ?: return null
+            return "${protoEnumName(enum)}::${value.name}"
+        }
+        return when (field.type) {
+            "string" -> "std::string(\"benchmark sample text\")"
+            "bytes" -> "std::string(1024, '\\x5a')"
+            "bool" -> "true"
+            "float", "double" -> "1.5"
+            "int32", "int64", "uint32", "uint64" -> "123456"
+            else -> null
+        }
+    }
+
+    private fun StringBuilder.appendBenchmarks(message: ParsedMessage) {
+        val name = message.name
+
+        appendLine("void BM_${name}_ToNative(benchmark::State& state) {")
+        appendLine("    $name proto;")
+        appendLine("    Populate(&proto, kPopulateDepth);")
+        appendLine("    for (auto _ : state) {")
+        appendLine("        auto native = ToNative(proto);")
+        appendLine("        benchmark::DoNotOptimize(native);")
+        appendLine("    }")
+        appendLine("}")
+        appendLine("BENCHMARK(BM_${name}_ToNative);")
+        appendLine()
+
+        appendLine("void BM_${name}_ToProto(benchmark::State& state) {")
+        appendLine("    $name proto;")
+        appendLine("    Populate(&proto, kPopulateDepth);")
+        appendLine("    const auto native = ToNative(proto);")
+        appendLine("    for (auto _ : state) {")
+        appendLine("        auto result = ToProto(native);")
+        appendLine("        benchmark::DoNotOptimize(result);")
+        appendLine("    }")
+        appendLine("}")
+        appendLine("BENCHMARK(BM_${name}_ToProto);")
+        appendLine()
+
+        appendLine("void BM_${name}_RoundTrip(benchmark::State& state) {")
+        appendLine("    $name proto;")
+        appendLine("    Populate(&proto, kPopulateDepth);")
+        appendLine("    for (auto _ : state) {")
+        appendLine("        auto result = ToProto(ToNative(proto));")
+        appendLine("        benchmark::DoNotOptimize(result);")
+        appendLine("    }")
+        appendLine("}")
+        appendLine("BENCHMARK(BM_${name}_RoundTrip);")
+        appendLine()
+
+        appendLine("void BM_${name}_ParseToNative(benchmark::State& state) {")
+        appendLine("    $name proto;")
+        appendLine("    Populate(&proto, kPopulateDepth);")
+        appendLine("    const std::string wire = proto.SerializeAsString();")
+        appendLine("    for (auto _ : state) {")
+        appendLine("        $name parsed;")
+        appendLine("        parsed.ParseFromString(wire);")
+        appendLine("        auto native = ToNative(std::move(parsed));")
+        appendLine("        benchmark::DoNotOptimize(native);")
+        appendLine("    }")
+        appendLine("    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(wire.size()));")
+        appendLine("}")
+        appendLine("BENCHMARK(BM_${name}_ParseToNative);")
+        appendLine()
+
+        appendLine("void BM_${name}_ToProtoSerialize(benchmark::State& state) {")
+        appendLine("    $name proto;")
+        appendLine("    Populate(&proto, kPopulateDepth);")
+        appendLine("    const auto native = ToNative(proto);")
+        appendLine("    std::string wire;")
+        appendLine("    for (auto _ : state) {")
+        appendLine("        ToProto(native).SerializeToString(&wire);")
+        appendLine("        benchmark::DoNotOptimize(wire);")
+        appendLine("    }")
+        appendLine("    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(wire.size()));")
+        appendLine("}")
+        appendLine("BENCHMARK(BM_${name}_ToProtoSerialize);")
+        appendLine()
+    }
+}
@@ -1,22 +1,6 @@
 package com.tomtom.sdk.tools.bindingsgenerator
 
 import java.io.File
-import java.time.Year
-
-private fun copyrightHeader() = """
-/*
- * © ${Year.now().value} TomTom NV. All rights reserved.
- *
- * This software is the proprietary copyright of TomTom NV and its subsidiaries and may be
- * used for internal evaluation purposes or commercial use strictly subject to separate
- * license agreement between you and TomTom NV. If you are the licensee, you are only permitted
- * to use this software in accordance with the terms of your license agreement. If you are
- * not the licensee, you are not authorized to use this software in any manner and should
- * immediately return or destroy it.
- */
-
-// AUTO-GENERATED FILE. DO NOT MODIFY.
-""".trimStart()
 
 /**
  * Configuration for the C++ generator.
@@ -24,11 +8,64 @@ private fun copyrightHeader() = """
  * @param namespaces Ordered list of namespace segments to nest. Defaults to ["protobuf_helpers"].
  * @param usePragmaOnce Emit `#pragma once` instead of `#ifndef`/`#define`/`#endif`. Defaults to false.
  * @param extraIncludes Additional `#include` lines to emit after the standard ones. Defaults to empty.
+ * @param emitArenaToProto Also emit `ToProto(const Native&, google::protobuf::Arena*)`, which builds the
+ *   whole proto tree on the given arena. Defaults to false.
+ * @param emitWireCodec Also emit `ByteSizeNative`/`SerializeNative`/`ParseNative`, which convert between
+ *   native structs and protobuf wire format without an intermediate proto object. Like protobuf's cached
+ *   sizes, `ByteSizeNative(native, &sizes)` records the size of every submessage in write order, and
+ *   `SerializeNative(native, &next, target)` consumes them, so nested messages are sized once per
+ *   serialization rather than once per enclosing level. Defaults to false.
+ * @param denseEnumTables Convert enums whose values are exactly 0..n-1 through `constexpr` lookup tables
+ *   instead of `switch`. The native enum must then use the proto numbering, which is checked by a
+ *   `static_assert`, so this is opt-in. Defaults to false.
+ * @param inlineSmallConversions Define the enum conversions (`constexpr`) and the ToNative/ToProto functions of
+ *   small leaf messages (`inline`) in the header, so callers in other translation units can inline them without
+ *   LTO. The header then needs the proto and native type definitions, usually via [extraIncludes]. Defaults to false.
+ * @param inlineMaxFieldCount Largest number of fields, oneof members included, that a message without submessage
+ *   fields may have to be defined in the header when [inlineSmallConversions] is set. Defaults to 4.
+ * @param emitViews Also emit `XView` classes that wrap a `const Proto&` and convert a field only when its
+ *   accessor is called. Views are defined in the header, which then needs the proto and native type
+ *   definitions, usually via [extraIncludes]. Defaults to false.
+ * @param emitBatchConversions Also emit `ToNativeBatch`/`ToProtoBatch`, which convert a contiguous array of
+ *   messages into a caller-provided output array. Defaults to false.
+ * @param parallelThreshold When set, batches and repeated message fields with at least this many elements are
+ *   converted with `std::execution::par`. Every element is written to its own pre-sized slot, so the output
+ *   order does not depend on scheduling. With libstdc++ the program must link TBB. Defaults to null
+ *   (always sequential).
+ * @param emitVisitors Also emit `ForEach<Field>(const Proto&, Callback)` for every repeated message field. It
+ *   converts one element at a time into a reused native object, so peak memory stays at one element. With C++20
+ *   `std::generator` a `Stream<Field>` coroutine is emitted as well. Visitors are templates defined in the header,
+ *   which then needs the proto and native type definitions, usually via [extraIncludes]. Defaults to false.
+ * @param emitPmrToNative Also emit `ToNative(const Proto&, std::pmr::memory_resource*)`, which builds the result
+ *   on the given resource. Native structs are written by hand, so they must be allocator-aware: declare
+ *   `allocator_type`, take it in a constructor and use `std::pmr` containers. Repeated elements are then added
+ *   with `emplace_back` so they are constructed with the container's allocator. Defaults to false.
+ * @param emitInstrumentation Also emit call counts, latency histograms and converted byte counts for the
+ *   out-of-line conversions. Bytes are counted for the outermost conversion of a call only. [generateHeader]
+ *   then also writes `conversion_stats.hpp` next to the header, which holds `SnapshotConversionStats`/
+ *   `ResetConversionStats` as inline functions over every helpers file linked into the program. All of it is
+ *   guarded by `#ifdef PROTOBUF_HELPERS_ENABLE_STATS`, so builds without the macro compile the plain
+ *   conversions. Defaults to false.
+ * @param emitByteSizeEstimate Also emit `EstimatedByteSize(const Native&)`, the encoded size of the proto that
+ *   ToProto would build, computed from the native struct's field numbers and wire types. Callers can size an
+ *   output buffer once before serializing. Defaults to false.
  */
 data class GeneratorConfig(
     val namespaces: List<String> = listOf("protobuf_helpers"),
     val usePragmaOnce: Boolean = false,
-    val extraIncludes: List<String> = emptyList()
+    val extraIncludes: List<String> = emptyList(),
+    val emitArenaToProto: Boolean = false,
+    val emitWireCodec: Boolean = false,
+    val denseEnumTables: Boolean = false,
+    val inlineSmallConversions: Boolean = false,
+    val inlineMaxFieldCount: Int = 4,
+    val emitViews: Boolean = false,
+    val emitBatchConversions: Boolean = false,
+    val parallelThreshold: Int? = null,
+    val emitVisitors: Boolean = false,
+    val emitPmrToNative: Boolean = false,
+    val emitInstrumentation: Boolean = false,
+    val emitByteSizeEstimate: Boolean = false
 ) {
     companion object {
         val DEFAULT = GeneratorConfig()
@@ -41,14 +78,14 @@ class CppGenerator(private val config: GeneratorConfig = GeneratorConfig.DEFAULT
     private val toNativeName = "ToNative"
     private val toProtoName = "ToProto"
 
-    fun generateHeader(parsedFile: ParsedProtoFile, outputFile: File) {
+    fun generateHeader(parsedFile: ParsedProtoFile, outputFile: File): List<File> {
         val guardName = outputFile.name
             .uppercase()
             .replace('.', '_')
             .replace('-', '_')
 
         val content = buildString {
-            append(copyrightHeader())
+            append(cppCopyrightHeader())
             appendLine()
             if (config.usePragmaOnce) {
                 appendLine("#pragma once")
@@ -57,8 +94,37 @@ class CppGenerator(private val config: GeneratorConfig = GeneratorConfig.DEFAULT
                 appendLine("#define $guardName")
             }
             appendLine()
+            if (config.emitWireCodec || config.emitBatchConversions || config.emitInstrumentation ||
+                config.emitByteSizeEstimate
+            ) {
+                appendLine("#include <cstddef>")
+            }
+            if (config.emitWireCodec) {
+                appendLine("#include <cstdint>")
+            }
+            if (config.emitPmrToNative) {
+                appendLine("#include <memory_resource>")
+            }
             appendLine("#include <string>")
+            appendLine("#include <utility>")
             appendLine("#include <vector>")
+            if (config.emitArenaToProto || config.emitWireCodec) {
+                appendLine()
+                if (config.emitArenaToProto) appendLine("#include <google/protobuf/arena.h>")
+                if (config.emitWireCodec) appendLine("#include <google/protobuf/io/coded_stream.h>")
+            }
+            if (config.emitVisitors) {
+                appendLine()
+                appendLine("#if __has_include(<generator>)")
+                appendLine("#include <generator>")
+                appendLine("#endif")
+            }
+            if (config.emitInstrumentation) {
+                appendLine()
+                appendLine("#ifdef $statsMacro")
+                appendLine("#include \"$statsHeaderName\"")
+                appendLine("#endif")
+            }
             if (config.extraIncludes.isNotEmpty()) {
                 appendLine()
                 config.extraIncludes.forEach { appendLine(it) }
@@ -78,6 +144,21 @@ class CppGenerator(private val config: GeneratorConfig = GeneratorConfig.DEFAULT
             appendEnumConversions(parsedFile.enums)
             appendMessageConversions(parsedFile.messages, parsedFile.enums)
 
+            if (config.inlineSmallConversions) {
+                appendLine("// Inline definitions")
+                appendLine()
+                appendEnumImplementations(parsedFile.enums)
+                appendMessageImplementations(parsedFile.messages, parsedFile.enums, inHeader = true)
+            }
+
+            if (config.emitVisitors) {
+                appendVisitors(allMessages)
+            }
+
+            if (config.emitViews && allMessages.isNotEmpty()) {
+                appendViews(allMessages)
+            }
+
             closeNamespaces()
             if (!config.usePragmaOnce) {
                 appendLine()
@@ -85,26 +166,103 @@ class CppGenerator(private val config: GeneratorConfig = GeneratorConfig.DEFAULT
             }
         }
 
-        outputFile.writeText(content)
+        writeIfChanged(outputFile, content)
+
+        if (config.emitInstrumentation) {
+            return listOf(outputFile) + generateStatsHeader(File(outputFile.absoluteFile.parentFile, statsHeaderName))
+        }
+        return listOf(outputFile)
     }
 
-    fun generateImplementation(parsedFile: ParsedProtoFile, headerFile: File, outputFile: File) {
+    /**
+     * Writes the stats API shared by every generated helpers file. Its content only depends on the
+     * namespaces, so the copies next to each header are interchangeable and one include guard covers them.
+     */
+    fun generateStatsHeader(outputFile: File): List<File> {
         val content = buildString {
-            append(copyrightHeader())
+            append(cppCopyrightHeader())
+            appendLine()
+            appendStatsHeader()
+        }
+
+        writeIfChanged(outputFile, content)
+        return listOf(outputFile)
+    }
+
+    fun generateImplementation(parsedFile: ParsedProtoFile, headerFile: File, outputFile: File): List<File> {
+        val content = buildString {
+            append(cppCopyrightHeader())
             appendLine()
             appendLine("#include \"${headerFile.name}\"")
             appendLine()
+            if (config.emitInstrumentation) {
+                appendLine("#ifdef $statsMacro")
+                appendLine("#include <algorithm>")
+                appendLine("#include <atomic>")
+                appendLine("#include <chrono>")
+                appendLine("#include <mutex>")
+                appendLine("#endif")
+                appendLine()
+            }
+            if (config.parallelThreshold != null) {
+                appendLine("#include <algorithm>")
+                appendLine("#include <execution>")
+                appendLine()
+            }
+            if (config.emitWireCodec) {
+                appendLine("#include <climits>")
+                appendLine()
+            }
+            if (config.emitWireCodec || config.emitByteSizeEstimate) {
+                appendLine("#include <google/protobuf/wire_format_lite.h>")
+                appendLine()
+            }
 
             openNamespaces()
             appendLine()
 
-            appendEnumImplementations(parsedFile.enums)
-            appendMessageImplementations(parsedFile.messages, parsedFile.enums)
+            if (config.emitWireCodec || config.emitByteSizeEstimate) {
+                appendLine("using google::protobuf::io::CodedInputStream;")
+                appendLine("using google::protobuf::io::CodedOutputStream;")
+                appendLine("using WFL = google::protobuf::internal::WireFormatLite;")
+                appendLine()
+            }
+
+            if (config.emitWireCodec) {
+                appendLine("namespace {")
+                appendLine()
+                appendLine("// Sizes a submessage once and records its size in the slot SerializeNative will read")
+                appendLine("template <typename Native>")
+                appendLine("size_t CachedLengthDelimitedSize(const Native& native, std::vector<uint32_t>* sizes) {")
+                appendLine("    const size_t slot = sizes->size();")
+                appendLine("    sizes->push_back(0);")
+                appendLine("    const size_t size = ByteSizeNative(native, sizes);")
+                appendLine("    (*sizes)[slot] = static_cast<uint32_t>(size);")
+                appendLine("    return WFL::LengthDelimitedSize(size);")
+                appendLine("}")
+                appendLine()
+                appendLine("}  // namespace")
+                appendLine()
+            }
+
+            if (config.emitInstrumentation) {
+                appendStatsRegistry(collectAllMessages(parsedFile.messages).filterNot { isInlineMessage(it) })
+            }
+
+            if (config.parallelThreshold != null) {
+                appendParallelForEach()
+            }
+
+            if (!config.inlineSmallConversions) {
+                appendEnumImplementations(parsedFile.enums)
+            }
+            appendMessageImplementations(parsedFile.messages, parsedFile.enums, inHeader = false)
 
             closeNamespaces()
         }
 
-        outputFile.writeText(content)
+        writeIfChanged(outputFile, content)
+        return listOf(outputFile)
     }
 
     private fun StringBuilder.openNamespaces() {
@@ -115,15 +273,6 @@ class CppGenerator(private val config: GeneratorConfig = GeneratorConfig.DEFAULT
         config.namespaces.reversed().forEach { ns -> appendLine("}  // namespace $ns") }
     }
 
-    private fun collectAllMessages(messages: List<ParsedMessage>): List<ParsedMessage> {
-        val result = mutableListOf<ParsedMessage>()
-        for (msg in messages) {
-            result.add(msg)
-            result.addAll(collectAllMessages(msg.nestedMessages))
-        }
-        return result
-    }
-
     private fun StringBuilder.generateMessageForwardDeclarations(messages: List<ParsedMessage>) {
         messages.forEach { message ->
             appendLine("struct ${message.name};")
@@ -134,8 +283,9 @@ class CppGenerator(private val config: GeneratorConfig = GeneratorConfig.DEFAULT
         enums.forEach { enum ->
             val nativeName = enum.name
             appendLine("// Conversion functions for $nativeName")
-            appendLine("$nativeName $toNativeName(const ${getProtoEnumName(enum)} proto);")
-            appendLine("${getProtoEnumName(enum)} $toProtoName(const $nativeName native);")
+            val spec = enumSpecifier()
+            appendLine("$spec$nativeName $toNativeName(const ${protoEnumName(enum)} proto);")
+            appendLine("$spec${protoEnumName(enum)} $toProtoName(const $nativeName native);")
             appendLine()
         }
     }
@@ -143,9 +293,36 @@ class CppGenerator(private val config: GeneratorConfig = GeneratorConfig.DEFAULT
     private fun StringBuilder.appendMessageConversions(messages: List<ParsedMessage>, enums: List<ParsedEnum>) {
         messages.forEach { message ->
             val nativeName = message.name
+            val spec = messageSpecifier(message)
             appendLine("// Conversion functions for $nativeName")
-            appendLine("$nativeName $toNativeName(const ${getProtoMessageName(message)} proto);")
-            appendLine("${getProtoMessageName(message)} $toProtoName(const $nativeName& native);")
+            appendLine("$spec$nativeName $toNativeName(const ${getProtoMessageName(message)}& proto);")
+            appendLine("${spec}void $toNativeName(const ${getProtoMessageName(message)}& proto, $nativeName* out);")
+            appendLine("$spec$nativeName $toNativeName(${getProtoMessageName(message)}&& proto);")
+            appendLine("${spec}void $toNativeName(${getProtoMessageName(message)}&& proto, $nativeName* out);")
+            if (config.emitPmrToNative) {
+                appendLine("$nativeName $toNativeName(const ${getProtoMessageName(message)}& proto, std::pmr::memory_resource* resource);")
+            }
+            appendLine("$spec${getProtoMessageName(message)} $toProtoName(const $nativeName& native);")
+            appendLine("${spec}void $toProtoName(const $nativeName& native, ${getProtoMessageName(message)}* out);")
+            if (config.emitArenaToProto) {
+                appendLine("${getProtoMessageName(message)}* $toProtoName(const $nativeName& native, google::protobuf::Arena* arena);")
+            }
+            if (config.emitBatchConversions) {
+                appendLine("void ${toNativeName}Batch(const ${getProtoMessageName(message)}* protos, size_t count, $nativeName* out);")
+                appendLine("void ${toProtoName}Batch(const $nativeName* natives, size_t count, ${getProtoMessageName(message)}* out);")
+            }
+            if (config.emitWireCodec) {
+                appendLine("size_t ByteSizeNative(const $nativeName& native);")
+                appendLine("uint8_t* SerializeNative(const $nativeName& native, uint8_t* target);")
+                appendLine("// Submessage sizes in write order, filled by the first and consumed by the second")
+                appendLine("size_t ByteSizeNative(const $nativeName& native, std::vector<uint32_t>* sizes);")
+                appendLine("uint8_t* SerializeNative(const $nativeName& native, const uint32_t** sizes, uint8_t* target);")
+                appendLine("bool ParseNative(const uint8_t* data, size_t size, $nativeName* out);")
+                appendLine("bool ParseNative(google::protobuf::io::CodedInputStream* input, $nativeName* out);")
+            }
+            if (config.emitByteSizeEstimate) {
+                appendLine("size_t EstimatedByteSize(const $nativeName& native);")
+            }
             appendLine()
             appendMessageConversions(message.nestedMessages, message.nestedEnums)
             appendEnumConversions(message.nestedEnums)
@@ -154,140 +331,1178 @@ class CppGenerator(private val config: GeneratorConfig = GeneratorConfig.DEFAULT
 
     private fun StringBuilder.appendEnumImplementations(enums: List<ParsedEnum>) {
         enums.forEach { enum ->
-            val nativeName = enum.name
-            val protoName = getProtoEnumName(enum)
+            if (config.denseEnumTables && isDenseEnum(enum)) {
+                appendDenseEnumImplementation(enum)
+            } else {
+                appendSwitchEnumImplementation(enum)
+            }
+        }
+    }
+
+    /** Enum conversions become `constexpr` header definitions in inline mode. */
+    private fun enumSpecifier(): String = if (config.inlineSmallConversions) "constexpr " else ""
+
+    /** Small messages without submessage fields get `inline` header definitions in inline mode. */
+    private fun isInlineMessage(message: ParsedMessage): Boolean {
+        if (!config.inlineSmallConversions) return false
+        val allFields = message.fields + message.oneofs.flatMap { it.fields }
+        return allFields.none { it.isMessage } && allFields.size <= config.inlineMaxFieldCount
+    }
+
+    private fun messageSpecifier(message: ParsedMessage): String = if (isInlineMessage(message)) "inline " else ""
+
+    /** An enum is dense when its values are exactly 0..n-1, so the value itself can index a table. */
+    private fun isDenseEnum(enum: ParsedEnum): Boolean =
+        enum.values.isNotEmpty() && enum.values.map { it.number }.sorted() == enum.values.indices.toList()
+
+    private fun StringBuilder.appendSwitchEnumImplementation(enum: ParsedEnum) {
+        val nativeName = enum.name
+        val protoName = protoEnumName(enum)
+        val spec = enumSpecifier()
 
-            appendLine("$nativeName $toNativeName(const $protoName proto) {")
-            appendLine("    switch (proto) {")
-            enum.values.forEach { value ->
-                val nativeValue = convertToNativeEnumValue(value.name, enum.name)
-                appendLine("        case $protoName::${value.name}: return $nativeName::$nativeValue;")
+        appendLine("$spec$nativeName $toNativeName(const $protoName proto) {")
+        appendLine("    switch (proto) {")
+        enum.values.forEach { value ->
+            val nativeValue = convertToNativeEnumValue(value.name, enum.name)
+            appendLine("        case $protoName::${value.name}: return $nativeName::$nativeValue;")
+        }
+        appendLine("        default: return $nativeName::${convertToNativeEnumValue(enum.values.first().name, enum.name)};")
+        appendLine("    }")
+        appendLine("}")
+        appendLine()
+
+        appendLine("$spec$protoName $toProtoName(const $nativeName native) {")
+        appendLine("    switch (native) {")
+        enum.values.forEach { value ->
+            val nativeValue = convertToNativeEnumValue(value.name, enum.name)
+            appendLine("        case $nativeName::$nativeValue: return $protoName::${value.name};")
+        }
+        appendLine("        default: return $protoName::${enum.values.first().name};")
+        appendLine("    }")
+        appendLine("}")
+        appendLine()
+    }
+
+    /**
+     * Emits branch-free table lookups for a dense enum. Out-of-range values (including negative ones,
+     * which wrap around in the unsigned index) fall back to the first value, like the `switch` default.
+     */
+    private fun StringBuilder.appendDenseEnumImplementation(enum: ParsedEnum) {
+        val nativeName = enum.name
+        val protoName = protoEnumName(enum)
+        val ordered = enum.values.sortedBy { it.number }
+        val nativeValues = ordered.map { "$nativeName::${convertToNativeEnumValue(it.name, enum.name)}" }
+        val protoValues = ordered.map { "$protoName::${it.name}" }
+        val size = ordered.size
+        val spec = enumSpecifier()
+        // Static locals are not allowed in constexpr functions before C++23
+        val table = if (config.inlineSmallConversions) "constexpr" else "static constexpr"
+
+        appendLine("$spec$nativeName $toNativeName(const $protoName proto) {")
+        appendLine("    $table $nativeName kTable[] = {")
+        nativeValues.forEach { appendLine("        $it,") }
+        appendLine("    };")
+        appendLine("    const unsigned index = static_cast<unsigned>(proto);")
+        appendLine("    return index < ${size}u ? kTable[index] : ${nativeValues.first()};")
+        appendLine("}")
+        appendLine()
+
+        appendLine("$spec$protoName $toProtoName(const $nativeName native) {")
+        nativeValues.forEachIndexed { i, value ->
+            val prefix = if (i == 0) "    static_assert(" else "                  "
+            val suffix = if (i == size - 1) "," else " &&"
+            appendLine("${prefix}static_cast<int>($value) == $i$suffix")
+        }
+        appendLine("                  \"$nativeName must follow the proto numbering of $protoName\");")
+        appendLine("    $table $protoName kTable[] = {")
+        protoValues.forEach { appendLine("        $it,") }
+        appendLine("    };")
+        appendLine("    const unsigned index = static_cast<unsigned>(native);")
+        appendLine("    return index < ${size}u ? kTable[index] : ${protoValues.first()};")
+        appendLine("}")
+        appendLine()
+    }
+
+    /**
+     * Emits the conversion bodies for [messages] and their nested types. With [inHeader] only the
+     * inline definitions are emitted; otherwise everything else, including arena and wire codec code.
+     */
+    private fun StringBuilder.appendMessageImplementations(
+        messages: List<ParsedMessage>,
+        knownEnums: List<ParsedEnum>,
+        inHeader: Boolean
+    ) {
+        messages.forEach { message ->
+            val allEnums = knownEnums + message.nestedEnums
+
+            if (isInlineMessage(message) == inHeader) {
+                appendConversionImplementations(message, allEnums)
             }
-            appendLine("        default: return $nativeName::${convertToNativeEnumValue(enum.values.first().name, enum.name)};")
-            appendLine("    }")
-            appendLine("}")
-            appendLine()
 
-            appendLine("$protoName $toProtoName(const $nativeName native) {")
-            appendLine("    switch (native) {")
-            enum.values.forEach { value ->
-                val nativeValue = convertToNativeEnumValue(value.name, enum.name)
-                appendLine("        case $nativeName::$nativeValue: return $protoName::${value.name};")
+            if (!inHeader && config.emitPmrToNative) {
+                val nativeName = message.name
+                val protoName = getProtoMessageName(message)
+                // PMR ToNative: nested containers pick up the resource through uses-allocator construction
+                appendLine("$nativeName $toNativeName(const $protoName& proto, std::pmr::memory_resource* resource) {")
+                appendLine("    $nativeName result($nativeName::allocator_type{resource});")
+                appendLine("    $toNativeName(proto, &result);")
+                appendLine("    return result;")
+                appendLine("}")
+                appendLine()
+            }
+
+            if (!inHeader && config.emitArenaToProto) {
+                val nativeName = message.name
+                val protoName = getProtoMessageName(message)
+                // Arena ToProto: mutable_x()/add_x() allocate on the root's arena, so the whole tree lands there
+                appendLine("$protoName* $toProtoName(const $nativeName& native, google::protobuf::Arena* arena) {")
+                appendLine("    $protoName* result = google::protobuf::Arena::CreateMessage<$protoName>(arena);")
+                appendLine("    $toProtoName(native, result);")
+                appendLine("    return result;")
+                appendLine("}")
+                appendLine()
+            }
+
+            if (!inHeader && config.emitBatchConversions) {
+                appendBatchImplementations(message)
+            }
+
+            if (!inHeader && config.emitWireCodec) {
+                appendWireCodecImplementation(message)
+            }
+
+            if (!inHeader && config.emitByteSizeEstimate) {
+                if (config.emitWireCodec) {
+                    appendLine("size_t EstimatedByteSize(const ${message.name}& native) {")
+                    appendLine("    return ByteSizeNative(native);")
+                    appendLine("}")
+                    appendLine()
+                } else {
+                    appendByteSizeImplementation(message, "EstimatedByteSize")
+                }
+            }
+
+            appendMessageImplementations(message.nestedMessages, allEnums, inHeader)
+            if (config.inlineSmallConversions == inHeader) {
+                appendEnumImplementations(message.nestedEnums)
             }
-            appendLine("        default: return $protoName::${enum.values.first().name};")
-            appendLine("    }")
-            appendLine("}")
-            appendLine()
         }
     }
 
-    private fun StringBuilder.appendMessageImplementations(messages: List<ParsedMessage>, knownEnums: List<ParsedEnum>) {
+    /** Batch conversions write element i to `out[i]`, so the parallel path keeps the input order. */
+    private fun StringBuilder.appendBatchImplementations(message: ParsedMessage) {
+        val nativeName = message.name
+        val protoName = getProtoMessageName(message)
+
+        appendLine("void ${toNativeName}Batch(const $protoName* protos, size_t count, $nativeName* out) {")
+        parallelOrSequential(
+            "count",
+            listOf("std::for_each(std::execution::par, protos, protos + count, [&](const $protoName& proto) { $toNativeName(proto, &out[&proto - protos]); });"),
+            listOf("for (size_t i = 0; i < count; ++i) { $toNativeName(protos[i], &out[i]); }")
+        ).forEach { appendLine("    $it") }
+        appendLine("}")
+        appendLine()
+
+        appendLine("void ${toProtoName}Batch(const $nativeName* natives, size_t count, $protoName* out) {")
+        parallelOrSequential(
+            "count",
+            listOf("std::for_each(std::execution::par, natives, natives + count, [&](const $nativeName& native) { $toProtoName(native, &out[&native - natives]); });"),
+            listOf("for (size_t i = 0; i < count; ++i) { $toProtoName(natives[i], &out[i]); }")
+        ).forEach { appendLine("    $it") }
+        appendLine("}")
+        appendLine()
+    }
+
+    /**
+     * Emits `ParallelForEach`, which converts the elements of a repeated message field in parallel. With
+     * stats enabled, each element runs at the nesting depth of the enclosing conversion: pool threads start
+     * at depth 0 and would otherwise count every element as an outermost conversion and size it again.
+     */
+    private fun StringBuilder.appendParallelForEach() {
+        appendLine("namespace {")
+        appendLine()
+        appendLine("template <typename Iterator, typename Function>")
+        appendLine("void ParallelForEach(Iterator first, Iterator last, Function function) {")
+        if (config.emitInstrumentation) {
+            appendLine("#ifdef $statsMacro")
+            appendLine("    const int depth = ConversionDepth();")
+            appendLine("#endif")
+        }
+        appendLine("    std::for_each(std::execution::par, first, last, [&](auto& item) {")
+        if (config.emitInstrumentation) {
+            appendLine("#ifdef $statsMacro")
+            appendLine("        const int saved = std::exchange(ConversionDepth(), depth);")
+            appendLine("#endif")
+        }
+        appendLine("        function(item);")
+        if (config.emitInstrumentation) {
+            appendLine("#ifdef $statsMacro")
+            appendLine("        ConversionDepth() = saved;")
+            appendLine("#endif")
+        }
+        appendLine("    });")
+        appendLine("}")
+        appendLine()
+        appendLine("}  // namespace")
+        appendLine()
+    }
+
+    /** Wraps [parallel] and [sequential] in a size check when [GeneratorConfig.parallelThreshold] is set. */
+    private fun parallelOrSequential(size: String, parallel: List<String>, sequential: List<String>): List<String> {
+        val threshold = config.parallelThreshold ?: return sequential
+        return listOf("if ($size >= $threshold) {") +
+            parallel.map { "    $it" } +
+            listOf("} else {") +
+            sequential.map { "    $it" } +
+            listOf("}")
+    }
+
+    /** Emits the ToNative and ToProto bodies for [message], `inline` when it is defined in the header. */
+    private fun StringBuilder.appendConversionImplementations(message: ParsedMessage, knownEnums: List<ParsedEnum>) {
+        val nativeName = message.name
+        val protoName = getProtoMessageName(message)
+        val spec = messageSpecifier(message)
+
+        appendToNativeImplementation(message, knownEnums, move = false)
+        appendToNativeImplementation(message, knownEnums, move = true)
+
+        // ToProto implementation: the by-value form delegates to the in-place one
+        appendLine("$spec$protoName $toProtoName(const $nativeName& native) {")
+        appendLine("    $protoName result;")
+        appendLine("    $toProtoName(native, &result);")
+        appendLine("    return result;")
+        appendLine("}")
+        appendLine()
+
+        // In-place ToProto: nested messages are written straight into the caller-owned tree
+        val instrumented = config.emitInstrumentation && !isInlineMessage(message)
+
+        appendLine("${spec}void $toProtoName(const $nativeName& native, $protoName* out) {")
+        if (instrumented) {
+            appendLine("#ifdef $statsMacro")
+            appendLine("    ConversionScope scope(${statsId("ToProto", message)});")
+            appendLine("#endif")
+        }
+        appendLine("    out->Clear();")
+        message.fields.forEach { field ->
+            generateToProtoFieldMapping(field, knownEnums).forEach { appendLine("    $it") }
+        }
+        // oneof fields
+        message.oneofs.forEach { oneof ->
+            oneof.fields.forEach { field ->
+                val nativeCase = "${nativeName}::k${field.name.replaceFirstChar { it.uppercase() }}"
+                appendLine("    if (native.${oneof.name}_case == $nativeCase) {")
+                if (field.isMessage) {
+                    appendLine("        $toProtoName(native.${field.name}, out->mutable_${field.protoName}());")
+                } else {
+                    appendLine("        out->set_${field.protoName}(native.${field.name});")
+                }
+                appendLine("    }")
+            }
+        }
+        if (instrumented) {
+            appendLine("#ifdef $statsMacro")
+            appendLine("    scope.RecordBytes(*out);")
+            appendLine("#endif")
+        }
+        appendLine("}")
+        appendLine()
+    }
+
+    // ── Instrumentation ──────────────────────────────────────────────────────────────────
+
+    private val statsMacro = "PROTOBUF_HELPERS_ENABLE_STATS"
+
+    private val statsFunctions = listOf("ToNative", "MoveToNative", "ToProto")
+
+    private fun statsId(function: String, message: ParsedMessage): String = "kStats${function}_${message.name}"
+
+    private fun statsLabel(function: String, message: ParsedMessage): String = when (function) {
+        "ToNative" -> "$toNativeName(const ${getProtoMessageName(message)}&)"
+        "MoveToNative" -> "$toNativeName(${getProtoMessageName(message)}&&)"
+        else -> "$toProtoName(const ${message.name}&)"
+    }
+
+    private val statsHeaderName = "conversion_stats.hpp"
+
+    private fun StringBuilder.appendStatsHeader() {
+        // One guard per namespace: helper sets generated into other namespaces keep their own registry
+        val guard = (config.namespaces + "CONVERSION_STATS_HPP")
+            .joinToString("_")
+            .uppercase()
+            .replace(':', '_')
+        appendLine("#ifndef $guard")
+        appendLine("#define $guard")
+        appendLine()
+        appendLine("#include <cstddef>")
+        appendLine("#include <mutex>")
+        appendLine("#include <vector>")
+        appendLine()
+        openNamespaces()
+        appendLine()
+        appendLine("inline constexpr size_t kLatencyBuckets = 32;")
+        appendLine()
+        appendLine("// Statistics of one conversion function since the last ResetConversionStats()")
+        appendLine("struct ConversionStats {")
+        appendLine("    const char* function;")
+        appendLine("    unsigned long long calls;")
+        appendLine("    // Encoded size of the messages converted by outermost calls; nested calls add nothing")
+        appendLine("    unsigned long long bytes;")
+        appendLine("    // latencyHistogram[i] counts calls that took [2^i, 2^(i+1)) nanoseconds")
+        appendLine("    unsigned long long latencyHistogram[kLatencyBuckets];")
+        appendLine("};")
+        appendLine()
+        appendLine("// Every generated helpers file registers its own counters once, at static initialization")
+        appendLine("struct ConversionStatsSource {")
+        appendLine("    void (*append)(std::vector<ConversionStats>* out);")
+        appendLine("    void (*reset)();")
+        appendLine("};")
+        appendLine()
+        appendLine("struct ConversionStatsSources {")
+        appendLine("    std::mutex mutex;")
+        appendLine("    std::vector<ConversionStatsSource> sources;")
+        appendLine("};")
+        appendLine()
+        appendLine("inline ConversionStatsSources& GetConversionStatsSources() {")
+        appendLine("    static ConversionStatsSources* sources = new ConversionStatsSources();  // never destroyed")
+        appendLine("    return *sources;")
+        appendLine("}")
+        appendLine()
+        appendLine("inline bool RegisterConversionStatsSource(ConversionStatsSource source) {")
+        appendLine("    ConversionStatsSources& registry = GetConversionStatsSources();")
+        appendLine("    std::lock_guard<std::mutex> lock(registry.mutex);")
+        appendLine("    registry.sources.push_back(source);")
+        appendLine("    return true;")
+        appendLine("}")
+        appendLine()
+        appendLine("// Nesting depth of conversions on this thread, across all helpers files")
+        appendLine("inline int& ConversionDepth() {")
+        appendLine("    thread_local int depth = 0;")
+        appendLine("    return depth;")
+        appendLine("}")
+        appendLine()
+        appendLine("inline std::vector<ConversionStats> SnapshotConversionStats() {")
+        appendLine("    ConversionStatsSources& registry = GetConversionStatsSources();")
+        appendLine("    std::lock_guard<std::mutex> lock(registry.mutex);")
+        appendLine("    std::vector<ConversionStats> stats;")
+        appendLine("    for (const ConversionStatsSource& source : registry.sources) source.append(&stats);")
+        appendLine("    return stats;")
+        appendLine("}")
+        appendLine()
+        appendLine("inline void ResetConversionStats() {")
+        appendLine("    ConversionStatsSources& registry = GetConversionStatsSources();")
+        appendLine("    std::lock_guard<std::mutex> lock(registry.mutex);")
+        appendLine("    for (const ConversionStatsSource& source : registry.sources) source.reset();")
+        appendLine("}")
+        appendLine()
+        closeNamespaces()
+        appendLine()
+        appendLine("#endif  // $guard")
+    }
+
+    /**
+     * Emits the per-thread stats registry. Each thread only writes its own counters, with relaxed
+     * load/store pairs and no locked instructions. The mutex is taken once per thread and by
+     * snapshot/reset. Reset records a baseline instead of zeroing, so it never races with writers.
+     * Everything has internal linkage and is reached through the source registered with the shared
+     * stats header, so any number of generated helpers files link into one program.
+     */
+    private fun StringBuilder.appendStatsRegistry(messages: List<ParsedMessage>) {
+        val ids = messages.flatMap { message -> statsFunctions.map { it to message } }
+
+        appendLine("#ifdef $statsMacro")
+        appendLine("namespace {")
+        appendLine()
+        appendLine("enum StatsId : size_t {")
+        ids.forEach { (function, message) -> appendLine("    ${statsId(function, message)},") }
+        appendLine("    kStatsCount")
+        appendLine("};")
+        appendLine()
+        appendLine("const char* const kStatsNames[] = {")
+        ids.forEach { (function, message) -> appendLine("    \"${statsLabel(function, message)}\",") }
+        appendLine("    \"\"")
+        appendLine("};")
+        appendLine()
+        appendLine("struct StatsCounters {")
+        appendLine("    std::atomic<unsigned long long> calls{0};")
+        appendLine("    std::atomic<unsigned long long> bytes{0};")
+        appendLine("    std::atomic<unsigned long long> latency[kLatencyBuckets] = {};")
+        appendLine("};")
+        appendLine()
+        appendLine("using StatsTotals = std::vector<ConversionStats>;")
+        appendLine()
+        appendLine("struct StatsRegistry {")
+        appendLine("    std::mutex mutex;")
+        appendLine("    std::vector<const StatsCounters*> live;")
+        appendLine("    StatsTotals retired = StatsTotals(kStatsCount);")
+        appendLine("    StatsTotals baseline = StatsTotals(kStatsCount);")
+        appendLine("};")
+        appendLine()
+        appendLine("StatsRegistry& Registry() {")
+        appendLine("    static StatsRegistry* registry = new StatsRegistry();  // never destroyed: threads may exit after main")
+        appendLine("    return *registry;")
+        appendLine("}")
+        appendLine()
+        appendLine("void Accumulate(const StatsCounters* counters, StatsTotals* totals) {")
+        appendLine("    for (size_t id = 0; id < kStatsCount; ++id) {")
+        appendLine("        ConversionStats& total = (*totals)[id];")
+        appendLine("        total.calls += counters[id].calls.load(std::memory_order_relaxed);")
+        appendLine("        total.bytes += counters[id].bytes.load(std::memory_order_relaxed);")
+        appendLine("        for (size_t bucket = 0; bucket < kLatencyBuckets; ++bucket) {")
+        appendLine("            total.latencyHistogram[bucket] += counters[id].latency[bucket].load(std::memory_order_relaxed);")
+        appendLine("        }")
+        appendLine("    }")
+        appendLine("}")
+        appendLine()
+        appendLine("// Must be called with the registry mutex held")
+        appendLine("StatsTotals CurrentTotals(StatsRegistry& registry) {")
+        appendLine("    StatsTotals totals = registry.retired;")
+        appendLine("    for (const StatsCounters* counters : registry.live) {")
+        appendLine("        Accumulate(counters, &totals);")
+        appendLine("    }")
+        appendLine("    return totals;")
+        appendLine("}")
+        appendLine()
+        appendLine("class ThreadStats {")
+        appendLine("public:")
+        appendLine("    ThreadStats() {")
+        appendLine("        std::lock_guard<std::mutex> lock(Registry().mutex);")
+        appendLine("        Registry().live.push_back(counters_);")
+        appendLine("    }")
+        appendLine()
+        appendLine("    ~ThreadStats() {")
+        appendLine("        StatsRegistry& registry = Registry();")
+        appendLine("        std::lock_guard<std::mutex> lock(registry.mutex);")
+        appendLine("        Accumulate(counters_, &registry.retired);")
+        appendLine("        registry.live.erase(std::find(registry.live.begin(), registry.live.end(), counters_));")
+        appendLine("    }")
+        appendLine()
+        appendLine("    StatsCounters& operator[](StatsId id) { return counters_[id]; }")
+        appendLine()
+        appendLine("private:")
+        appendLine("    StatsCounters counters_[kStatsCount];")
+        appendLine("};")
+        appendLine()
+        appendLine("// Only the owning thread writes, so a relaxed load/store pair replaces a locked read-modify-write")
+        appendLine("void Add(std::atomic<unsigned long long>& counter, unsigned long long value) {")
+        appendLine("    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);")
+        appendLine("}")
+        appendLine()
+        appendLine("size_t LatencyBucket(unsigned long long nanos) {")
+        appendLine("    size_t bucket = 0;")
+        appendLine("    while (nanos > 1 && bucket + 1 < kLatencyBuckets) {")
+        appendLine("        nanos >>= 1;")
+        appendLine("        ++bucket;")
+        appendLine("    }")
+        appendLine("    return bucket;")
+        appendLine("}")
+        appendLine()
+        appendLine("class ConversionScope {")
+        appendLine("public:")
+        appendLine("    explicit ConversionScope(StatsId id)")
+        appendLine("        : id_(id), topLevel_(ConversionDepth()++ == 0), start_(std::chrono::steady_clock::now()) {}")
+        appendLine()
+        appendLine("    ~ConversionScope() {")
+        appendLine("        const auto elapsed = std::chrono::steady_clock::now() - start_ - excluded_;")
+        appendLine("        --ConversionDepth();")
+        appendLine("        const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();")
+        appendLine("        thread_local ThreadStats stats;")
+        appendLine("        StatsCounters& counters = stats[id_];")
+        appendLine("        Add(counters.calls, 1);")
+        appendLine("        Add(counters.bytes, bytes_);")
+        appendLine("        Add(counters.latency[LatencyBucket(static_cast<unsigned long long>(nanos))], 1);")
+        appendLine("    }")
+        appendLine()
+        appendLine("    // Only the outermost conversion is sized: nested messages are part of it, and sizing every")
+        appendLine("    // level would repeat the work. The time spent sizing is left out of the latency.")
+        appendLine("    template <typename Message>")
+        appendLine("    void RecordBytes(const Message& message) {")
+        appendLine("        if (!topLevel_) return;")
+        appendLine("        const auto start = std::chrono::steady_clock::now();")
+        appendLine("        bytes_ = message.ByteSizeLong();")
+        appendLine("        excluded_ += std::chrono::steady_clock::now() - start;")
+        appendLine("    }")
+        appendLine()
+        appendLine("private:")
+        appendLine("    StatsId id_;")
+        appendLine("    bool topLevel_;")
+        appendLine("    std::chrono::steady_clock::time_point start_;")
+        appendLine("    std::chrono::steady_clock::duration excluded_{};")
+        appendLine("    size_t bytes_ = 0;")
+        appendLine("};")
+        appendLine()
+        appendLine("void AppendStats(std::vector<ConversionStats>* out) {")
+        appendLine("    StatsRegistry& registry = Registry();")
+        appendLine("    std::lock_guard<std::mutex> lock(registry.mutex);")
+        appendLine("    StatsTotals totals = CurrentTotals(registry);")
+        appendLine("    for (size_t id = 0; id < kStatsCount; ++id) {")
+        appendLine("        totals[id].function = kStatsNames[id];")
+        appendLine("        totals[id].calls -= registry.baseline[id].calls;")
+        appendLine("        totals[id].bytes -= registry.baseline[id].bytes;")
+        appendLine("        for (size_t bucket = 0; bucket < kLatencyBuckets; ++bucket) {")
+        appendLine("            totals[id].latencyHistogram[bucket] -= registry.baseline[id].latencyHistogram[bucket];")
+        appendLine("        }")
+        appendLine("        out->push_back(totals[id]);")
+        appendLine("    }")
+        appendLine("}")
+        appendLine()
+        appendLine("void ResetStats() {")
+        appendLine("    StatsRegistry& registry = Registry();")
+        appendLine("    std::lock_guard<std::mutex> lock(registry.mutex);")
+        appendLine("    registry.baseline = CurrentTotals(registry);")
+        appendLine("}")
+        appendLine()
+        appendLine("const bool kStatsRegistered = RegisterConversionStatsSource({&AppendStats, &ResetStats});")
+        appendLine()
+        appendLine("}  // namespace")
+        appendLine("#endif")
+        appendLine()
+    }
+
+    /**
+     * Emits the streaming visitors for the repeated message fields of [messages]. Each element is
+     * converted in place into the same native object, which keeps its buffers between elements.
+     */
+    private fun StringBuilder.appendVisitors(messages: List<ParsedMessage>) {
         messages.forEach { message ->
-            val nativeName = message.name
             val protoName = getProtoMessageName(message)
-            val allEnums = knownEnums + message.nestedEnums
+            message.fields.filter { it.isRepeated && it.isMessage }.forEach { field ->
+                val suffix = field.name.replaceFirstChar { it.uppercase() }
+                appendLine("template <typename Callback>")
+                appendLine("void ForEach$suffix(const $protoName& proto, Callback&& callback) {")
+                appendLine("    ${field.type} item;")
+                appendLine("    for (const auto& element : proto.${field.protoName}()) {")
+                appendLine("        $toNativeName(element, &item);")
+                appendLine("        callback(item);")
+                appendLine("    }")
+                appendLine("}")
+                appendLine()
+                appendLine("#ifdef __cpp_lib_generator")
+                appendLine("inline std::generator<const ${field.type}&> Stream$suffix(const $protoName& proto) {")
+                appendLine("    ${field.type} item;")
+                appendLine("    for (const auto& element : proto.${field.protoName}()) {")
+                appendLine("        $toNativeName(element, &item);")
+                appendLine("        co_yield item;")
+                appendLine("    }")
+                appendLine("}")
+                appendLine("#endif")
+                appendLine()
+            }
+        }
+    }
 
-            // ToNative implementation
-            appendLine("$nativeName $toNativeName(const $protoName proto) {")
-            appendLine("    $nativeName result;")
-            message.fields.forEach { field ->
-                val fieldAccess = generateToNativeFieldMapping(field, allEnums)
-                if (fieldAccess != null) appendLine("    $fieldAccess")
-            }
-            // oneof fields
-            message.oneofs.forEach { oneof ->
-                appendLine("    switch (proto.${oneof.name}_case()) {")
-                oneof.fields.forEach { field ->
-                    val caseLabel = "${protoName}::k${field.name.replaceFirstChar { it.uppercase() }}"
-                    val access = generateToNativeFieldMapping(field, allEnums)
-                    appendLine("        case $caseLabel: result.${field.name} = proto.${field.protoName}(); break;")
+    /**
+     * Emits the `XView` classes. All classes are declared before any accessor is defined, so views
+     * can return each other regardless of message order.
+     */
+    private fun StringBuilder.appendViews(messages: List<ParsedMessage>) {
+        appendLine("// Range over a repeated proto field that converts each element when it is dereferenced")
+        appendLine("template <typename Repeated, typename Convert>")
+        appendLine("class LazyRange {")
+        appendLine("public:")
+        appendLine("    class iterator {")
+        appendLine("    public:")
+        appendLine("        iterator(typename Repeated::const_iterator it, Convert convert) : it_(it), convert_(convert) {}")
+        appendLine("        auto operator*() const { return convert_(*it_); }")
+        appendLine("        iterator& operator++() { ++it_; return *this; }")
+        appendLine("        bool operator==(const iterator& other) const { return it_ == other.it_; }")
+        appendLine("        bool operator!=(const iterator& other) const { return it_ != other.it_; }")
+        appendLine()
+        appendLine("    private:")
+        appendLine("        typename Repeated::const_iterator it_;")
+        appendLine("        Convert convert_;")
+        appendLine("    };")
+        appendLine()
+        appendLine("    LazyRange(const Repeated& repeated, Convert convert) : repeated_(&repeated), convert_(convert) {}")
+        appendLine("    iterator begin() const { return iterator(repeated_->begin(), convert_); }")
+        appendLine("    iterator end() const { return iterator(repeated_->end(), convert_); }")
+        appendLine("    int size() const { return repeated_->size(); }")
+        appendLine("    bool empty() const { return repeated_->empty(); }")
+        appendLine("    auto operator[](int i) const { return convert_(repeated_->Get(i)); }")
+        appendLine()
+        appendLine("private:")
+        appendLine("    const Repeated* repeated_;")
+        appendLine("    Convert convert_;")
+        appendLine("};")
+        appendLine()
+        appendLine("template <typename Repeated, typename Convert>")
+        appendLine("LazyRange<Repeated, Convert> MakeLazyRange(const Repeated& repeated, Convert convert) {")
+        appendLine("    return LazyRange<Repeated, Convert>(repeated, convert);")
+        appendLine("}")
+        appendLine()
+
+        messages.forEach { appendLine("class ${it.name}View;") }
+        appendLine()
+        messages.forEach { appendViewClass(it) }
+        messages.forEach { appendViewAccessors(it) }
+    }
+
+    private fun viewFields(message: ParsedMessage): List<ParsedField> =
+        message.fields + message.oneofs.flatMap { it.fields }
+
+    private fun hasAccessorName(field: ParsedField): String = "has${field.name.replaceFirstChar { it.uppercase() }}"
+
+    private fun StringBuilder.appendViewClass(message: ParsedMessage) {
+        val viewName = "${message.name}View"
+        val protoName = getProtoMessageName(message)
+
+        appendLine("// Lazy view over $protoName: each accessor converts one field when called")
+        appendLine("class $viewName {")
+        appendLine("public:")
+        appendLine("    explicit $viewName(const $protoName& proto) : proto_(&proto) {}")
+        appendLine("    const $protoName& proto() const { return *proto_; }")
+        viewFields(message).forEach { field ->
+            when {
+                field.isRepeated && (field.isMessage || field.isEnum) -> appendLine("    auto ${field.name}() const;")
+                field.isRepeated -> appendLine("    decltype(auto) ${field.name}() const;")
+                field.isMessage -> {
+                    appendLine("    bool ${hasAccessorName(field)}() const;")
+                    appendLine("    ${field.type}View ${field.name}() const;")
                 }
-                appendLine("        default: break;")
-                appendLine("    }")
+                field.isEnum -> appendLine("    ${field.type} ${field.name}() const;")
+                field.isOptional -> {
+                    appendLine("    bool ${hasAccessorName(field)}() const;")
+                    appendLine("    decltype(auto) ${field.name}() const;")
+                }
+                else -> appendLine("    decltype(auto) ${field.name}() const;")
             }
-            appendLine("    return result;")
-            appendLine("}")
-            appendLine()
+        }
+        appendLine()
+        appendLine("private:")
+        appendLine("    const $protoName* proto_;")
+        appendLine("};")
+        appendLine()
+    }
+
+    /** Strings and bytes are returned by reference into the proto, so untouched buffers are never copied. */
+    private fun StringBuilder.appendViewAccessors(message: ParsedMessage) {
+        val viewName = "${message.name}View"
+        val fields = viewFields(message)
+        if (fields.isEmpty()) return
 
-            // ToProto implementation
-            appendLine("$protoName $toProtoName(const $nativeName& native) {")
-            appendLine("    $protoName result;")
-            message.fields.forEach { field ->
-                val fieldAccess = generateToProtoFieldMapping(field, allEnums)
-                if (fieldAccess != null) {
-                    if (field.isRepeated) {
-                        appendLine("    for (const auto& item : native.${field.name}) {")
-                        appendLine("        result.add_${field.protoName}($fieldAccess);")
-                        appendLine("    }")
-                    } else {
-                        appendLine("    $fieldAccess")
-                    }
+        fields.forEach { field ->
+            val get = "proto_->${field.protoName}()"
+            val has = "inline bool $viewName::${hasAccessorName(field)}() const { return proto_->has_${field.protoName}(); }"
+            when {
+                field.isRepeated && field.isMessage -> {
+                    appendLine("inline auto $viewName::${field.name}() const {")
+                    appendLine("    return MakeLazyRange($get, [](const ${field.type}& item) { return ${field.type}View(item); });")
+                    appendLine("}")
                 }
+                field.isRepeated && field.isEnum -> {
+                    appendLine("inline auto $viewName::${field.name}() const {")
+                    appendLine("    return MakeLazyRange($get, [](int item) { return $toNativeName(static_cast<${protoEnumTypeName(field)}>(item)); });")
+                    appendLine("}")
+                }
+                field.isRepeated -> appendLine("inline decltype(auto) $viewName::${field.name}() const { return $get; }")
+                field.isMessage -> {
+                    appendLine(has)
+                    appendLine("inline ${field.type}View $viewName::${field.name}() const { return ${field.type}View($get); }")
+                }
+                field.isEnum -> appendLine("inline ${field.type} $viewName::${field.name}() const { return $toNativeName($get); }")
+                field.isOptional -> {
+                    appendLine(has)
+                    appendLine("inline decltype(auto) $viewName::${field.name}() const { return $get; }")
+                }
+                else -> appendLine("inline decltype(auto) $viewName::${field.name}() const { return $get; }")
             }
-            // oneof fields
-            message.oneofs.forEach { oneof ->
-                oneof.fields.forEach { field ->
-                    val nativeCase = "${nativeName}::k${field.name.replaceFirstChar { it.uppercase() }}"
-                    appendLine("    if (native.${oneof.name}_case == $nativeCase) {")
-                    appendLine("        result.set_${field.protoName}(native.${field.name});")
-                    appendLine("    }")
+        }
+        appendLine()
+    }
+
+    /**
+     * Emits the by-value and in-place ToNative pair for [message]. The by-value form delegates
+     * to the in-place one. With [move] both take `Proto&&` and steal string, bytes, repeated and
+     * submessage buffers from the message instead of copying them.
+     *
+     * A oneof is reset before the active member is written: every member is cleared and the native
+     * `<oneof>_case` discriminator is set to its zero value, which stands for "not set" as protobuf's
+     * `<ONEOF>_NOT_SET` does. The active case then sets the member and the discriminator.
+     */
+    private fun StringBuilder.appendToNativeImplementation(
+        message: ParsedMessage,
+        knownEnums: List<ParsedEnum>,
+        move: Boolean
+    ) {
+        val nativeName = message.name
+        val protoName = getProtoMessageName(message)
+        val param = if (move) "$protoName&& proto" else "const $protoName& proto"
+        val spec = messageSpecifier(message)
+
+        appendLine("$spec$nativeName $toNativeName($param) {")
+        appendLine("    $nativeName result;")
+        appendLine("    $toNativeName(${if (move) "std::move(proto)" else "proto"}, &result);")
+        appendLine("    return result;")
+        appendLine("}")
+        appendLine()
+
+        appendLine("${spec}void $toNativeName($param, $nativeName* out) {")
+        if (config.emitInstrumentation && !isInlineMessage(message)) {
+            // Measured up front: the rvalue overload moves buffers out of the proto
+            appendLine("#ifdef $statsMacro")
+            appendLine("    ConversionScope scope(${statsId(if (move) "MoveToNative" else "ToNative", message)});")
+            appendLine("    scope.RecordBytes(proto);")
+            appendLine("#endif")
+        }
+        message.fields.forEach { field ->
+            val statements = if (move) {
+                generateMoveToNativeFieldMapping(field, knownEnums)
+            } else {
+                generateToNativeFieldMapping(field, knownEnums)
+            }
+            statements.forEach { appendLine("    $it") }
+        }
+        // oneof fields: reset first, so a reused out never keeps the member of an earlier case
+        message.oneofs.forEach { oneof ->
+            appendLine("    out->${oneof.name}_case = {};")
+            oneof.fields.forEach { field -> appendLine("    out->${field.name} = {};") }
+            appendLine("    switch (proto.${oneof.name}_case()) {")
+            oneof.fields.forEach { field ->
+                val caseLabel = "${protoName}::k${field.name.replaceFirstChar { it.uppercase() }}"
+                val assignment = when {
+                    field.isMessage && move ->
+                        "$toNativeName(std::move(*proto.mutable_${field.protoName}()), &out->${field.name});"
+                    field.isMessage -> "$toNativeName(proto.${field.protoName}(), &out->${field.name});"
+                    move && isBufferField(field) -> "out->${field.name} = std::move(*proto.mutable_${field.protoName}());"
+                    else -> "out->${field.name} = ${getNativeConversion(field, knownEnums, "proto.${field.protoName}()")};"
                 }
+                appendLine("        case $caseLabel: $assignment out->${oneof.name}_case = $nativeName::k${field.name.replaceFirstChar { it.uppercase() }}; break;")
             }
-            appendLine("    return result;")
-            appendLine("}")
-            appendLine()
+            appendLine("        default: break;")
+            appendLine("    }")
+        }
+        appendLine("}")
+        appendLine()
+    }
 
-            appendMessageImplementations(message.nestedMessages, allEnums)
-            appendEnumImplementations(message.nestedEnums)
+    /**
+     * Returns the statements that write [field] of `proto` into `*out`.
+     * Every branch overwrites the previous value, so a reused `out` never keeps stale data.
+     */
+    private fun generateToNativeFieldMapping(field: ParsedField, knownEnums: List<ParsedEnum>): List<String> {
+        return when {
+            field.isRepeated && field.isMessage -> listOf("out->${field.name}.resize(proto.${field.protoName}_size());") +
+                parallelOrSequential(
+                    "proto.${field.protoName}_size()",
+                    listOf("ParallelForEach(out->${field.name}.begin(), out->${field.name}.end(), [&](${field.type}& item) { $toNativeName(proto.${field.protoName}(${nativeIndex(field)}), &item); });"),
+                    listOf("for (int i = 0; i < proto.${field.protoName}_size(); ++i) { $toNativeName(proto.${field.protoName}(i), &out->${field.name}[i]); }")
+                )
+            field.isRepeated -> listOf(
+                "out->${field.name}.clear();",
+                "out->${field.name}.reserve(proto.${field.protoName}_size());",
+                "for (const auto& item : proto.${field.protoName}()) { out->${field.name}.${appendElement()}(${getNativeConversion(field, knownEnums, "item")}); }"
+            )
+            field.isOptional && !field.isEnum && !field.isMessage -> listOf(
+                "if (proto.has_${field.protoName}()) { out->${field.name} = proto.${field.protoName}(); } else { out->${field.name}.reset(); }"
+            )
+            field.isEnum -> listOf("out->${field.name} = $toNativeName(proto.${field.protoName}());")
+            field.isMessage -> listOf("$toNativeName(proto.${field.protoName}(), &out->${field.name});")
+            else -> listOf("out->${field.name} = proto.${field.protoName}();")
         }
     }
 
-    private fun generateToNativeFieldMapping(field: ParsedField, knownEnums: List<ParsedEnum>): String? {
+    /**
+     * Like [generateToNativeFieldMapping], but moves string/bytes values, repeated elements and
+     * submessages out of an expiring `proto`. Scalars and enums are copied as usual.
+     */
+    private fun generateMoveToNativeFieldMapping(field: ParsedField, knownEnums: List<ParsedEnum>): List<String> {
         return when {
-            field.isRepeated -> "for (const auto& item : proto.${field.protoName}()) { result.${field.name}.push_back(${getNativeConversion(field, knownEnums, "item")}); }"
-            field.isOptional && !field.isEnum && !field.isMessage ->
-                "if (proto.has_${field.protoName}()) { result.${field.name} = proto.${field.protoName}(); }"
-            field.isEnum -> "result.${field.name} = $toNativeName(proto.${field.protoName}());"
-            field.isMessage -> "result.${field.name} = $toNativeName(proto.${field.protoName}());"
-            else -> "result.${field.name} = proto.${field.protoName}();"
+            field.isRepeated && field.isMessage -> listOf("out->${field.name}.resize(proto.${field.protoName}_size());") +
+                parallelOrSequential(
+                    "proto.${field.protoName}_size()",
+                    listOf("ParallelForEach(out->${field.name}.begin(), out->${field.name}.end(), [&](${field.type}& item) { $toNativeName(std::move(*proto.mutable_${field.protoName}(${nativeIndex(field)})), &item); });"),
+                    listOf("for (int i = 0; i < proto.${field.protoName}_size(); ++i) { $toNativeName(std::move(*proto.mutable_${field.protoName}(i)), &out->${field.name}[i]); }")
+                )
+            field.isRepeated && isBufferField(field) -> listOf(
+                "out->${field.name}.clear();",
+                "out->${field.name}.reserve(proto.${field.protoName}_size());",
+                "for (auto& item : *proto.mutable_${field.protoName}()) { out->${field.name}.${appendElement()}(std::move(item)); }"
+            )
+            field.isMessage -> listOf(
+                "if (proto.has_${field.protoName}()) { $toNativeName(std::move(*proto.mutable_${field.protoName}()), &out->${field.name}); } else { $toNativeName(proto.${field.protoName}(), &out->${field.name}); }"
+            )
+            field.isOptional && isBufferField(field) -> listOf(
+                "if (proto.has_${field.protoName}()) { out->${field.name} = std::move(*proto.mutable_${field.protoName}()); } else { out->${field.name}.reset(); }"
+            )
+            isBufferField(field) -> listOf("out->${field.name} = std::move(*proto.mutable_${field.protoName}());")
+            else -> generateToNativeFieldMapping(field, knownEnums)
         }
     }
 
-    private fun generateToProtoFieldMapping(field: ParsedField, knownEnums: List<ParsedEnum>): String? {
+    /**
+     * Returns the statements that write [field] of `native` into `*out`, which has just been cleared.
+     * Submessages and repeated message elements are filled in place through `mutable_x()` and `add_x()`.
+     */
+    private fun generateToProtoFieldMapping(field: ParsedField, knownEnums: List<ParsedEnum>): List<String> {
         return when {
-            field.isRepeated -> "item"
-            field.isOptional && !field.isEnum && !field.isMessage ->
-                "if (native.${field.name}.has_value()) { result.set_${field.protoName}(native.${field.name}.value()); }"
-            field.isEnum -> "result.set_${field.protoName}($toProtoName(native.${field.name}));"
-            field.isMessage -> "result.mutable_${field.protoName}()->CopyFrom($toProtoName(native.${field.name}));"
-            else -> "result.set_${field.protoName}(native.${field.name});"
+            field.isRepeated && field.isMessage -> listOf(reserveRepeated(field)) +
+                parallelOrSequential(
+                    "native.${field.name}.size()",
+                    listOf(
+                        "for (size_t i = 0; i < native.${field.name}.size(); ++i) { out->add_${field.protoName}(); }",
+                        "ParallelForEach(native.${field.name}.begin(), native.${field.name}.end(), [&](const ${field.type}& item) { $toProtoName(item, out->mutable_${field.protoName}(static_cast<int>(&item - native.${field.name}.data()))); });"
+                    ),
+                    listOf(
+                        "for (const auto& item : native.${field.name}) {",
+                        "    $toProtoName(item, out->add_${field.protoName}());",
+                        "}"
+                    )
+                )
+            field.isRepeated -> listOf(
+                reserveRepeated(field),
+                "for (const auto& item : native.${field.name}) {",
+                "    out->add_${field.protoName}(item);",
+                "}"
+            )
+            field.isOptional && !field.isEnum && !field.isMessage -> listOf(
+                "if (native.${field.name}.has_value()) { out->set_${field.protoName}(native.${field.name}.value()); }"
+            )
+            field.isEnum -> listOf("out->set_${field.protoName}($toProtoName(native.${field.name}));")
+            field.isMessage -> listOf("$toProtoName(native.${field.name}, out->mutable_${field.protoName}());")
+            else -> listOf("out->set_${field.protoName}(native.${field.name});")
         }
     }
 
-    private fun getNativeConversion(field: ParsedField, knownEnums: List<ParsedEnum>, accessor: String): String {
+    /** `emplace_back` lets allocator-aware containers construct elements with their own allocator. */
+    private fun appendElement(): String = if (config.emitPmrToNative) "emplace_back" else "push_back"
+
+    private fun reserveRepeated(field: ParsedField): String =
+        "out->mutable_${field.protoName}()->Reserve(static_cast<int>(native.${field.name}.size()));"
+
+    /** Index of `item` within `out->x`, for parallel loops that walk the pre-sized native vector. */
+    private fun nativeIndex(field: ParsedField): String = "static_cast<int>(&item - out->${field.name}.data())"
+
+    // ── Direct native <-> wire format codec ─────────────────────────────────────────────
+
+    /** Wire-level description of a proto scalar type. [fixedSize] is set for types with a constant encoded size. */
+    private data class WireScalar(val cppType: String, val wflName: String, val wireType: Int, val fixedSize: String? = null)
+
+    private val wireScalars = mapOf(
+        "int32" to WireScalar("int32_t", "Int32", 0),
+        "int64" to WireScalar("int64_t", "Int64", 0),
+        "uint32" to WireScalar("uint32_t", "UInt32", 0),
+        "uint64" to WireScalar("uint64_t", "UInt64", 0),
+        "sint32" to WireScalar("int32_t", "SInt32", 0),
+        "sint64" to WireScalar("int64_t", "SInt64", 0),
+        "bool" to WireScalar("bool", "Bool", 0, "WFL::kBoolSize"),
+        "enum" to WireScalar("int", "Enum", 0),
+        "fixed32" to WireScalar("uint32_t", "Fixed32", 5, "WFL::kFixed32Size"),
+        "sfixed32" to WireScalar("int32_t", "SFixed32", 5, "WFL::kSFixed32Size"),
+        "float" to WireScalar("float", "Float", 5, "WFL::kFloatSize"),
+        "fixed64" to WireScalar("uint64_t", "Fixed64", 1, "WFL::kFixed64Size"),
+        "sfixed64" to WireScalar("int64_t", "SFixed64", 1, "WFL::kSFixed64Size"),
+        "double" to WireScalar("double", "Double", 1, "WFL::kDoubleSize")
+    )
+
+    private val wireTypeLengthDelimited = 2
+
+    /** A field as seen by the wire codec; [oneof] is set for members of a real oneof. */
+    private data class WireField(val field: ParsedField, val oneof: ParsedOneof?)
+
+    private fun wireFields(message: ParsedMessage): List<WireField> =
+        (message.fields.map { WireField(it, null) } +
+            message.oneofs.flatMap { oneof -> oneof.fields.map { WireField(it, oneof) } })
+            .sortedBy { it.field.number }
+
+    /** Exact proto type of [field], falling back to the collapsed [ParsedField.type] for hand-built models. */
+    private fun wireProtoType(field: ParsedField): String = field.protoType.ifEmpty {
+        when {
+            field.isEnum -> "enum"
+            field.isMessage -> "message"
+            else -> field.type
+        }
+    }
+
+    private fun wireScalar(field: ParsedField): WireScalar? = wireScalars[wireProtoType(field)]
+
+    private fun wireTag(number: Int, wireType: Int): String = "${(number.toLong() shl 3) or wireType.toLong()}u"
+
+    private fun tagSize(number: Int): Int {
+        var value = number.toLong() shl 3
+        var size = 1
+        while (value >= 0x80) {
+            value = value ushr 7
+            size++
+        }
+        return size
+    }
+
+    /** C++ name of the generated proto enum type of [field], e.g. `JunctionViewError_ErrorType`. */
+    private fun protoEnumTypeName(field: ParsedField): String =
+        field.typeName.split('.').filter { it.isNotEmpty() && it[0].isUpperCase() }.joinToString("_").ifEmpty { field.type }
+
+    /** Wire value of a native scalar [value]; enums go through the generated ToProto. */
+    private fun wireValue(field: ParsedField, value: String): String =
+        if (field.isEnum) "static_cast<int>($toProtoName($value))" else value
+
+    /** Native value of a decoded wire scalar [value]. */
+    private fun nativeValue(field: ParsedField, value: String): String =
+        if (field.isEnum) "$toNativeName(static_cast<${protoEnumTypeName(field)}>($value))" else value
+
+    private fun wireElementSize(
+        field: ParsedField,
+        value: String,
+        sizeFunction: String = "ByteSizeNative",
+        cacheSizes: Boolean = false
+    ): String {
+        val scalar = wireScalar(field)
         return when {
-            field.isEnum -> "$toNativeName($accessor)"
-            field.isMessage -> "$toNativeName($accessor)"
-            else -> accessor
+            field.isMessage && cacheSizes -> "CachedLengthDelimitedSize($value, sizes)"
+            field.isMessage -> "WFL::LengthDelimitedSize($sizeFunction($value))"
+            scalar == null -> "WFL::${if (wireProtoType(field) == "bytes") "Bytes" else "String"}Size($value)"
+            scalar.fixedSize != null -> scalar.fixedSize
+            else -> "WFL::${scalar.wflName}Size(${wireValue(field, value)})"
         }
     }
 
     /**
-     * Returns the C++ type name for a proto enum.
-     * For nested enums protobuf mangles "ParentMessage.EnumName" to "ParentMessage_EnumName".
-     * fullName is e.g. "com.test.JunctionViewError.ErrorType" — take the last two segments
-     * separated by '.' and join with '_'.
+     * Condition under which a singular field is written. Proto3 fields without presence are skipped
+     * when they hold the default value, matching what the protobuf runtime emits.
      */
-    private fun getProtoEnumName(enum: ParsedEnum): String {
-        val parts = enum.fullName.split(".")
-        return if (parts.size >= 2 && parts[parts.size - 2][0].isUpperCase()) {
-            // nested: ParentMessage_EnumName
-            "${parts[parts.size - 2]}_${parts.last()}"
+    private fun wirePresence(message: ParsedMessage, wireField: WireField): String? {
+        val field = wireField.field
+        val oneof = wireField.oneof
+        return when {
+            oneof != null -> "native.${oneof.name}_case == ${message.name}::k${field.name.replaceFirstChar { it.uppercase() }}"
+            field.isOptional -> "native.${field.name}.has_value()"
+            field.isMessage -> null
+            wireScalar(field) == null -> "!native.${field.name}.empty()"
+            field.type == "bool" -> "native.${field.name}"
+            else -> "${wireValue(field, "native.${field.name}")} != 0"
+        }
+    }
+
+    private fun singularValue(wireField: WireField): String =
+        if (wireField.field.isOptional) "*native.${wireField.field.name}" else "native.${wireField.field.name}"
+
+    private fun packedPayloadLines(field: ParsedField, scalar: WireScalar): List<String> =
+        if (scalar.fixedSize != null) {
+            listOf("const size_t payload = native.${field.name}.size() * ${scalar.fixedSize};")
         } else {
-            enum.name
+            listOf(
+                "size_t payload = 0;",
+                "for (const auto& item : native.${field.name}) { payload += WFL::${scalar.wflName}Size(${wireValue(field, "item")}); }"
+            )
+        }
+
+    private fun wireWriteLines(field: ParsedField, value: String): List<String> {
+        val scalar = wireScalar(field)
+        return when {
+            field.isMessage -> listOf(
+                "target = CodedOutputStream::WriteTagToArray(${wireTag(field.number, wireTypeLengthDelimited)}, target);",
+                "target = CodedOutputStream::WriteVarint32ToArray(*(*sizes)++, target);",
+                "target = SerializeNative($value, sizes, target);"
+            )
+            scalar == null -> listOf(
+                "target = WFL::Write${if (wireProtoType(field) == "bytes") "Bytes" else "String"}ToArray(${field.number}, $value, target);"
+            )
+            else -> listOf("target = WFL::Write${scalar.wflName}ToArray(${field.number}, ${wireValue(field, value)}, target);")
         }
     }
 
+    /** Statements that decode one occurrence of [field] from `input` and store it through [store]. */
+    private fun wireReadLines(field: ParsedField, store: (String) -> String, target: String): List<String> {
+        val scalar = wireScalar(field)
+        return when {
+            field.isMessage -> listOf(
+                "uint32_t length;",
+                "if (!input->ReadVarint32(&length)) return false;",
+                "const auto limit = input->IncrementRecursionDepthAndPushLimit(static_cast<int>(length));",
+                "if (limit.second < 0 || !ParseNative(input, $target)) return false;",
+                "if (!input->DecrementRecursionDepthAndPopLimit(limit.first)) return false;"
+            )
+            scalar == null -> listOf(
+                "std::string value;",
+                "if (!WFL::Read${if (wireProtoType(field) == "bytes") "Bytes" else "String"}(input, &value)) return false;",
+                store("std::move(value)")
+            )
+            else -> listOf(
+                "${scalar.cppType} value;",
+                "if (!WFL::ReadPrimitive<${scalar.cppType}, WFL::TYPE_${wireProtoType(field).uppercase()}>(input, &value)) return false;",
+                store(nativeValue(field, "value"))
+            )
+        }
+    }
+
+    private fun hasWireSubmessages(message: ParsedMessage): Boolean = wireFields(message).any { it.field.isMessage }
+
+    /**
+     * Emits `size_t [functionName](const Native&)`, the exact encoded size of the message. Submessage
+     * sizes recurse through the same function. With [cacheSizes] the function takes the `sizes` list
+     * and records every submessage size in it, in the order `SerializeNative` writes them.
+     */
+    private fun StringBuilder.appendByteSizeImplementation(
+        message: ParsedMessage,
+        functionName: String,
+        cacheSizes: Boolean = false
+    ) {
+        val fields = wireFields(message)
+
+        val sizesParameter = when {
+            !cacheSizes -> ""
+            hasWireSubmessages(message) -> ", std::vector<uint32_t>* sizes"
+            else -> ", std::vector<uint32_t>* /*sizes*/"
+        }
+        appendLine("size_t $functionName(const ${message.name}& native$sizesParameter) {")
+        appendLine("    size_t total = 0;")
+        fields.forEach { wireField ->
+            val field = wireField.field
+            val tagSize = tagSize(field.number)
+            val scalar = wireScalar(field)
+            when {
+                field.isRepeated && scalar != null -> {
+                    appendLine("    if (!native.${field.name}.empty()) {")
+                    packedPayloadLines(field, scalar).forEach { appendLine("        $it") }
+                    appendLine("        total += $tagSize + WFL::LengthDelimitedSize(payload);")
+                    appendLine("    }")
+                }
+                field.isRepeated -> {
+                    val size = wireElementSize(field, "item", functionName, cacheSizes)
+                    appendLine("    for (const auto& item : native.${field.name}) { total += $tagSize + $size; }")
+                }
+                else -> {
+                    val statement = "total += $tagSize + ${wireElementSize(field, singularValue(wireField), functionName, cacheSizes)};"
+                    val presence = wirePresence(message, wireField)
+                    appendLine(if (presence != null) "    if ($presence) { $statement }" else "    $statement")
+                }
+            }
+        }
+        appendLine("    return total;")
+        appendLine("}")
+        appendLine()
+    }
+
+    /**
+     * Emits both `ByteSizeNative`, both `SerializeNative` and both `ParseNative` overloads for [message].
+     * They read and write protobuf wire format straight from the native struct, so the output stays
+     * parseable by any protobuf runtime. Repeated scalars are written packed and accepted either way.
+     * Serializing sizes the tree once up front; the length prefixes then come from that pass, instead of
+     * re-sizing each submessage at every level above it.
+     */
+    private fun StringBuilder.appendWireCodecImplementation(message: ParsedMessage) {
+        val nativeName = message.name
+        val fields = wireFields(message)
+        val hasSubmessages = hasWireSubmessages(message)
+
+        appendByteSizeImplementation(message, "ByteSizeNative")
+        appendByteSizeImplementation(message, "ByteSizeNative", cacheSizes = true)
+
+        appendLine("uint8_t* SerializeNative(const $nativeName& native, uint8_t* target) {")
+        if (hasSubmessages) {
+            appendLine("    std::vector<uint32_t> sizes;")
+            appendLine("    ByteSizeNative(native, &sizes);")
+            appendLine("    const uint32_t* next = sizes.data();")
+            appendLine("    return SerializeNative(native, &next, target);")
+        } else {
+            appendLine("    return SerializeNative(native, nullptr, target);")
+        }
+        appendLine("}")
+        appendLine()
+
+        val sizesParameter = if (hasSubmessages) "const uint32_t** sizes" else "const uint32_t** /*sizes*/"
+        appendLine("uint8_t* SerializeNative(const $nativeName& native, $sizesParameter, uint8_t* target) {")
+        fields.forEach { wireField ->
+            val field = wireField.field
+            val scalar = wireScalar(field)
+            when {
+                field.isRepeated && scalar != null -> {
+                    appendLine("    if (!native.${field.name}.empty()) {")
+                    packedPayloadLines(field, scalar).forEach { appendLine("        $it") }
+                    appendLine("        target = CodedOutputStream::WriteTagToArray(${wireTag(field.number, wireTypeLengthDelimited)}, target);")
+                    appendLine("        target = CodedOutputStream::WriteVarint32ToArray(static_cast<uint32_t>(payload), target);")
+                    appendLine("        for (const auto& item : native.${field.name}) { target = WFL::Write${scalar.wflName}NoTagToArray(${wireValue(field, "item")}, target); }")
+                    appendLine("    }")
+                }
+                field.isRepeated -> {
+                    appendLine("    for (const auto& item : native.${field.name}) {")
+                    wireWriteLines(field, "item").forEach { appendLine("        $it") }
+                    appendLine("    }")
+                }
+                else -> {
+                    val presence = wirePresence(message, wireField)
+                    val indent = if (presence != null) "        " else "    "
+                    if (presence != null) appendLine("    if ($presence) {")
+                    wireWriteLines(field, singularValue(wireField)).forEach { appendLine("$indent$it") }
+                    if (presence != null) appendLine("    }")
+                }
+            }
+        }
+        appendLine("    return target;")
+        appendLine("}")
+        appendLine()
+
+        appendLine("bool ParseNative(const uint8_t* data, size_t size, $nativeName* out) {")
+        appendLine("    // CodedInputStream takes an int size")
+        appendLine("    if (size > static_cast<size_t>(INT_MAX)) return false;")
+        appendLine("    *out = $nativeName();")
+        appendLine("    CodedInputStream input(data, static_cast<int>(size));")
+        appendLine("    return ParseNative(&input, out) && input.ConsumedEntireMessage();")
+        appendLine("}")
+        appendLine()
+
+        appendLine("bool ParseNative(CodedInputStream* input, $nativeName* out) {")
+        appendLine("    for (;;) {")
+        appendLine("        const uint32_t tag = input->ReadTag();")
+        appendLine("        if (tag == 0) return true;")
+        appendLine("        switch (tag) {")
+        fields.forEach { wireField ->
+            val field = wireField.field
+            val scalar = wireScalar(field)
+            val oneof = wireField.oneof
+            val caseName = "$nativeName::k${field.name.replaceFirstChar { it.uppercase() }}"
+            val setCase = oneof?.let { "out->${it.name}_case = $caseName;" }
+            // Switching to another member drops the one set earlier in the parse, as in ToNative; the
+            // same member again merges, as protobuf does
+            val resetOneof = oneof?.let {
+                "if (out->${it.name}_case != $caseName) { out->${it.name}_case = {}; " +
+                    it.fields.joinToString(" ") { member -> "out->${member.name} = {};" } + " }"
+            }
+            val store: (String) -> String = if (field.isRepeated) {
+                { value -> "out->${field.name}.push_back($value);" }
+            } else {
+                { value -> "out->${field.name} = $value;" + (setCase?.let { " $it" } ?: "") }
+            }
+            if (field.isRepeated && scalar != null) {
+                appendLine("            case ${wireTag(field.number, wireTypeLengthDelimited)}: {")
+                appendLine("                uint32_t length;")
+                appendLine("                if (!input->ReadVarint32(&length)) return false;")
+                appendLine("                const auto limit = input->PushLimit(static_cast<int>(length));")
+                appendLine("                while (input->BytesUntilLimit() > 0) {")
+                wireReadLines(field, store, "").forEach { appendLine("                    $it") }
+                appendLine("                }")
+                appendLine("                input->PopLimit(limit);")
+                appendLine("                break;")
+                appendLine("            }")
+            }
+            val wireType = scalar?.wireType ?: wireTypeLengthDelimited
+            val target = if (field.isRepeated) "&out->${field.name}.emplace_back()" else "&out->${field.name}"
+            appendLine("            case ${wireTag(field.number, wireType)}: {")
+            resetOneof?.let { appendLine("                $it") }
+            wireReadLines(field, store, target).forEach { appendLine("                $it") }
+            if (field.isMessage && setCase != null) appendLine("                $setCase")
+            appendLine("                break;")
+            appendLine("            }")
+        }
+        appendLine("            default:")
+        appendLine("                if (!WFL::SkipField(input, tag)) return false;")
+        appendLine("                break;")
+        appendLine("        }")
+        appendLine("    }")
+        appendLine("}")
+        appendLine()
+    }
+
+    private fun getNativeConversion(field: ParsedField, knownEnums: List<ParsedEnum>, accessor: String): String {
+        return when {
+            field.isEnum -> "$toNativeName($accessor)"
+            field.isMessage -> "$toNativeName($accessor)"
+            else -> accessor
+        }
+    }
+
+    private fun isBufferField(field: ParsedField): Boolean =
+        !field.isEnum && !field.isMessage && (field.type == "string" || field.type == "bytes")
+
     private fun getProtoMessageName(message: ParsedMessage): String = message.name
 
     private fun convertToNativeEnumValue(protoValueName: String, enumName: String): String {
@@ -0,0 +1,59 @@
+package com.tomtom.sdk.tools.bindingsgenerator
+
+private const val AUTO_GENERATED_NOTE = "AUTO-GENERATED FILE. DO NOT MODIFY."
+
+/** Copyright notice stamped into every generated file, without comment markers. */
+internal fun copyrightLines(): List<String> = listOf(
+    "© $copyrightYear TomTom NV. All rights reserved.",
+    "",
+    "This software is the proprietary copyright of TomTom NV and its subsidiaries and may be",
+    "used for internal evaluation purposes or commercial use strictly subject to separate",
+    "license agreement between you and TomTom NV. If you are the licensee, you are only permitted",
+    "to use this software in accordance with the terms of your license agreement. If you are",
+    "not the licensee, you are not authorized to use this software in any manner and should",
+    "immediately return or destroy it."
+)
+
+/** [copyrightLines] in a block comment, followed by the do-not-modify note, for C++ sources. */
+internal fun cppCopyrightHeader(): String = buildString {
+    appendLine("/*")
+    copyrightLines().forEach { appendLine(if (it.isEmpty()) " *" else " * $it") }
+    appendLine(" */")
+    appendLine()
+    appendLine("// $AUTO_GENERATED_NOTE")
+}
+
+/** [copyrightLines] and the do-not-modify note as line comments starting with [marker], e.g. `#`. */
+internal fun lineCommentCopyrightHeader(marker: String): String = buildString {
+    copyrightLines().forEach { appendLine(if (it.isEmpty()) marker else "$marker $it") }
+    appendLine()
+    appendLine("$marker $AUTO_GENERATED_NOTE")
+}
+
+/** [copyrightLines] and the do-not-modify note for `FileSpec.Builder.addFileComment`, which adds the `//`. */
+internal fun kotlinFileComment(): String = (copyrightLines() + listOf("", AUTO_GENERATED_NOTE, "")).joinToString("\n")
+
+/** [messages] and all of their nested messages, depth first, each parent before its children. */
+internal fun collectAllMessages(messages: List<ParsedMessage>): List<ParsedMessage> =
+    messages.flatMap { listOf(it) + collectAllMessages(it.nestedMessages) }
+
+/** Every enum of [parsedFile], top-level and nested, by full name. */
+internal fun collectAllEnums(parsedFile: ParsedProtoFile): Map<String, ParsedEnum> =
+    (parsedFile.enums + collectAllMessages(parsedFile.messages).flatMap { it.nestedEnums })
+        .associateBy { it.fullName }
+
+/**
+ * Returns the C++ type name for a proto enum.
+ * For nested enums protobuf mangles "ParentMessage.EnumName" to "ParentMessage_EnumName".
+ * fullName is e.g. "com.test.JunctionViewError.ErrorType" — take the last two segments
+ * separated by '.' and join with '_'.
+ */
+internal fun protoEnumName(enum: ParsedEnum): String {
+    val parts = enum.fullName.split(".")
+    return if (parts.size >= 2 && parts[parts.size - 2][0].isUpperCase()) {
+        // nested: ParentMessage_EnumName
+        "${parts[parts.size - 2]}_${parts.last()}"
+    } else {
+        enum.name
+    }
+}
@@ -0,0 +1,193 @@
+package com.tomtom.sdk.tools.bindingsgenerator
+
+import java.io.File
+
+/**
+ * Generates the C++ JNI entry points for the services of a proto file. The matching Kotlin
+ * `external` declarations come from [KotlinGenerator.generateNativeBindings].
+ *
+ * Requests and responses cross the boundary in direct `ByteBuffer`s owned by the Kotlin side. The
+ * request is parsed straight from the buffer memory, and the response is serialized straight into
+ * it, so the payload is never copied through a `jbyteArray`. A response that does not fit is written
+ * into a new, larger direct buffer, which the Kotlin side keeps for later calls.
+ *
+ * For every rpc `Foo(Request) returns (Response)` the native library implements
+ * `void Foo(jlong handle, const Request& request, Response* response)` in [GeneratorConfig.namespaces].
+ * Exceptions it throws are rethrown in Kotlin as `RuntimeException`.
+ */
+class JniGenerator(private val config: GeneratorConfig = GeneratorConfig.DEFAULT) {
+
+    fun generateGlue(parsedFile: ParsedProtoFile, outputFile: File): List<File> {
+        val content = buildString {
+            append(cppCopyrightHeader())
+            appendLine()
+            appendLine("#include <jni.h>")
+            appendLine()
+            appendLine("#include <cstdint>")
+            appendLine("#include <exception>")
+            appendLine("#include <limits>")
+            appendLine()
+            appendLine("#include <google/protobuf/io/coded_stream.h>")
+            appendLine("#include <google/protobuf/io/zero_copy_stream_impl_lite.h>")
+            appendLine("#include <google/protobuf/message_lite.h>")
+            if (config.extraIncludes.isNotEmpty()) {
+                appendLine()
+                config.extraIncludes.forEach { appendLine(it) }
+            }
+            appendLine()
+
+            config.namespaces.forEach { appendLine("namespace $it {") }
+            appendLine()
+            parsedFile.services.forEach { service ->
+                appendLine("// Implemented by the native library for ${service.name}")
+                service.methods.forEach { method ->
+                    val request = protoTypeName(method.inputType, parsedFile.protoPackage)
+                    val response = protoTypeName(method.outputType, parsedFile.protoPackage)
+                    appendLine("void ${method.name}(jlong handle, const $request& request, $response* response);")
+                }
+                appendLine()
+            }
+            config.namespaces.reversed().forEach { appendLine("}  // namespace $it") }
+            appendLine()
+
+            appendSupport()
+
+            parsedFile.services.forEach { service ->
+                service.methods.forEach { method -> appendEntryPoint(parsedFile.protoPackage, service, method) }
+            }
+        }
+
+        writeIfChanged(outputFile, content)
+        return listOf(outputFile)
+    }
+
+    private fun StringBuilder.appendSupport() {
+        appendLine("namespace {")
+        appendLine()
+        appendLine("struct BufferMethods {")
+        appendLine("    jclass byteBuffer;")
+        appendLine("    jmethodID allocateDirect;")
+        appendLine("    jmethodID limit;")
+        appendLine("};")
+        appendLine()
+        appendLine("const BufferMethods& GetBufferMethods(JNIEnv* env) {")
+        appendLine("    static const BufferMethods methods = [env] {")
+        appendLine("        jclass local = env->FindClass(\"java/nio/ByteBuffer\");")
+        appendLine("        BufferMethods result{static_cast<jclass>(env->NewGlobalRef(local)),")
+        appendLine("                             env->GetStaticMethodID(local, \"allocateDirect\", \"(I)Ljava/nio/ByteBuffer;\"),")
+        appendLine("                             env->GetMethodID(local, \"limit\", \"(I)Ljava/nio/Buffer;\")};")
+        appendLine("        env->DeleteLocalRef(local);")
+        appendLine("        return result;")
+        appendLine("    }();")
+        appendLine("    return methods;")
+        appendLine("}")
+        appendLine()
+        appendLine("void ThrowJava(JNIEnv* env, const char* className, const char* message) {")
+        appendLine("    jclass exceptionClass = env->FindClass(className);")
+        appendLine("    if (exceptionClass != nullptr) {")
+        appendLine("        env->ThrowNew(exceptionClass, message);")
+        appendLine("        env->DeleteLocalRef(exceptionClass);")
+        appendLine("    }")
+        appendLine("}")
+        appendLine()
+        appendLine("// Parses the first size bytes of a direct buffer in place")
+        appendLine("bool ParseDirect(JNIEnv* env, jobject buffer, jint size, google::protobuf::MessageLite* out) {")
+        appendLine("    void* data = env->GetDirectBufferAddress(buffer);")
+        appendLine("    if (data == nullptr || size < 0 || size > env->GetDirectBufferCapacity(buffer)) return false;")
+        appendLine("    google::protobuf::io::ArrayInputStream stream(data, size);")
+        appendLine("    google::protobuf::io::CodedInputStream input(&stream);")
+        appendLine("    return out->MergeFromCodedStream(&input) && input.ConsumedEntireMessage();")
+        appendLine("}")
+        appendLine()
+        appendLine("// Serializes into buffer, or into a new direct buffer if buffer is too small. Returns the")
+        appendLine("// buffer holding the response, with its limit set to the encoded size.")
+        appendLine("jobject SerializeDirect(JNIEnv* env, const google::protobuf::MessageLite& message, jobject buffer) {")
+        appendLine("    const size_t size = message.ByteSizeLong();")
+        appendLine("    if (size > static_cast<size_t>(std::numeric_limits<jint>::max())) {")
+        appendLine("        ThrowJava(env, \"java/lang/IllegalStateException\", \"Response exceeds 2 GB\");")
+        appendLine("        return nullptr;")
+        appendLine("    }")
+        appendLine("    const BufferMethods& methods = GetBufferMethods(env);")
+        appendLine("    jobject target = buffer;")
+        appendLine("    if (static_cast<jlong>(size) > env->GetDirectBufferCapacity(buffer)) {")
+        appendLine("        target = env->CallStaticObjectMethod(methods.byteBuffer, methods.allocateDirect, static_cast<jint>(size));")
+        appendLine("        if (target == nullptr) return nullptr;")
+        appendLine("    }")
+        appendLine("    auto* data = static_cast<uint8_t*>(env->GetDirectBufferAddress(target));")
+        appendLine("    if (data == nullptr) {")
+        appendLine("        ThrowJava(env, \"java/lang/IllegalArgumentException\", \"Response buffer is not a direct buffer\");")
+        appendLine("        return nullptr;")
+        appendLine("    }")
+        appendLine("    message.SerializeWithCachedSizesToArray(data);")
+        appendLine("    env->DeleteLocalRef(env->CallObjectMethod(target, methods.limit, static_cast<jint>(size)));")
+        appendLine("    return target;")
+        appendLine("}")
+        appendLine()
+        appendLine("}  // namespace")
+        appendLine()
+    }
+
+    private fun StringBuilder.appendEntryPoint(protoPackage: String, service: ParsedService, method: ParsedMethod) {
+        val request = protoTypeName(method.inputType, protoPackage)
+        val response = protoTypeName(method.outputType, protoPackage)
+        val symbol = listOf(protoPackage.replace('.', '/'), bindingsClassName(service), nativeMethodName(method))
+            .joinToString("_", prefix = "Java_") { mangle(it) }
+
+        appendLine("extern \"C\" JNIEXPORT jobject JNICALL")
+        appendLine("$symbol(JNIEnv* env, jobject /* this */, jlong handle, jobject request, jint requestSize, jobject response) {")
+        appendLine("    if (env->GetDirectBufferAddress(request) == nullptr || env->GetDirectBufferAddress(response) == nullptr) {")
+        appendLine("        ThrowJava(env, \"java/lang/IllegalArgumentException\", \"Request and response must be direct buffers\");")
+        appendLine("        return nullptr;")
+        appendLine("    }")
+        appendLine("    $request requestProto;")
+        appendLine("    if (!ParseDirect(env, request, requestSize, &requestProto)) {")
+        appendLine("        ThrowJava(env, \"java/lang/IllegalArgumentException\", \"Malformed $request\");")
+        appendLine("        return nullptr;")
+        appendLine("    }")
+        appendLine("    $response responseProto;")
+        appendLine("    try {")
+        appendLine("        ${config.namespaces.joinToString("::")}::${method.name}(handle, requestProto, &responseProto);")
+        appendLine("    } catch (const std::exception& e) {")
+        appendLine("        ThrowJava(env, \"java/lang/RuntimeException\", e.what());")
+        appendLine("        return nullptr;")
+        appendLine("    }")
+        appendLine("    return SerializeDirect(env, responseProto, response);")
+        appendLine("}")
+        appendLine()
+    }
+
+    /** C++ name of a proto message type, e.g. `.pkg.Outer.Inner` becomes `Outer_Inner`. */
+    private fun protoTypeName(typeName: String, protoPackage: String): String {
+        val prefix = ".$protoPackage."
+        return if (typeName.startsWith(prefix)) {
+            typeName.removePrefix(prefix).replace('.', '_')
+        } else {
+            typeName.substringAfterLast('.')
+        }
+    }
+
+    /** Escapes a name for a JNI symbol as described in the JNI specification. */
+    private fun mangle(name: String): String = buildString {
+        name.forEach { c ->
+            when {
+                c == '/' -> append('_')
+                c == '_' -> append("_1")
+                c == ';' -> append("_2")
+                c == '[' -> append("_3")
+                c.code < 128 && c.isLetterOrDigit() -> append(c)
+                else -> append("_0").append(String.format("%04x", c.code))
+            }
+        }
+    }
+
+    companion object {
+        /** Kotlin class holding the `external` declarations of [service]. */
+        fun bindingsClassName(service: ParsedService): String = "${service.name}Jni"
+
+        /** Kotlin name of the public wrapper for [method]. */
+        fun kotlinMethodName(method: ParsedMethod): String = method.name.replaceFirstChar { it.lowercase() }
+
+        /** Kotlin name of the `external` function for [method]. */
+        fun nativeMethodName(method: ParsedMethod): String = "native${method.name}"
+    }
+}
@@ -0,0 +1,195 @@
+package com.tomtom.sdk.tools.bindingsgenerator
+
+import com.squareup.kotlinpoet.AnnotationSpec
+import com.squareup.kotlinpoet.BYTE_ARRAY
+import com.squareup.kotlinpoet.ClassName
+import com.squareup.kotlinpoet.CodeBlock
+import com.squareup.kotlinpoet.FileSpec
+import com.squareup.kotlinpoet.FunSpec
+import com.squareup.kotlinpoet.KModifier
+import com.squareup.kotlinpoet.PropertySpec
+import com.squareup.kotlinpoet.TypeName
+import com.squareup.kotlinpoet.TypeSpec
+import java.io.File
+
+private const val JMH_PACKAGE = "org.openjdk.jmh.annotations"
+
+/**
+ * Generates a JMH benchmark class for the mappers emitted by [KotlinGenerator], plus a Gradle script
+ * that adds a `jmh` source set running it with the GC profiler, so allocations per operation are
+ * reported next to the timings.
+ *
+ * Every message gets `toProto()`, `toNative()`, `toByteArray()` and `parseFrom()` benchmarks. Inputs are
+ * built by generated `sample` functions that set a non-default value for every field, as
+ * [CppBenchmarkGenerator] does, and stop recursing into submessages after [populateDepth] levels.
+ */
+class KotlinBenchmarkGenerator(
+    private val populateDepth: Int = 3,
+    private val repeatedCount: Int = 8
+) {
+
+    fun generateBenchmark(parsedFile: ParsedProtoFile, className: String, outputDir: File): List<File> {
+        val kotlinPackage = parsedFile.protoPackage
+        val allMessages = collectAllMessages(parsedFile.messages)
+        val allEnums = collectAllEnums(parsedFile)
+
+        val type = TypeSpec.classBuilder(className)
+            .addModifiers(KModifier.OPEN)
+            .addAnnotation(jmhAnnotation("State", CodeBlock.of("%T.Benchmark", ClassName(JMH_PACKAGE, "Scope"))))
+            .addAnnotation(jmhAnnotation("BenchmarkMode", CodeBlock.of("%T.AverageTime", ClassName(JMH_PACKAGE, "Mode"))))
+            .addAnnotation(
+                jmhAnnotation("OutputTimeUnit", CodeBlock.of("%T.NANOSECONDS", ClassName("java.util.concurrent", "TimeUnit")))
+            )
+            .addAnnotation(jmhAnnotation("Warmup", CodeBlock.of("iterations = 3, time = 1")))
+            .addAnnotation(jmhAnnotation("Measurement", CodeBlock.of("iterations = 5, time = 1")))
+            .addAnnotation(jmhAnnotation("Fork", CodeBlock.of("1")))
+            .apply {
+                allMessages.forEach { message ->
+                    val protoClassName = ClassName(kotlinPackage, message.name)
+                    addProperty(stateProperty("${propertyPrefix(message)}Proto", protoClassName))
+                    addProperty(stateProperty("${propertyPrefix(message)}Native", protoClassName))
+                    addProperty(stateProperty("${propertyPrefix(message)}Bytes", BYTE_ARRAY))
+                }
+                addFunction(buildSetUp(allMessages))
+                allMessages.forEach { message -> addBenchmarks(message, kotlinPackage) }
+                allMessages.forEach { message -> addFunction(buildSample(message, kotlinPackage, allEnums)) }
+            }
+            .build()
+
+        outputDir.mkdirs()
+        return FileSpec.builder(kotlinPackage, className)
+            .addFileComment(kotlinFileComment())
+            .addType(type)
+            .build()
+            .writeToIfChanged(outputDir)
+            .let { listOf(it) }
+    }
+
+    /**
+     * Writes a Gradle script to apply with `apply(from = ...)` in a JVM, non-Android, module that compiles
+     * the proto classes, the native model classes and `NativeModelMapper.kt`. It applies `java`, then the
+     * JMH plugin, and adds [benchmarkDir] to its `jmh` source set; `./gradlew jmh` then runs the benchmarks
+     * with `-prof gc`. The plugin is applied by type: a plugin id is not resolved from the private
+     * `buildscript` classpath of a script plugin.
+     */
+    fun generateGradle(benchmarkDir: File, outputFile: File): List<File> {
+        val relativeDir = benchmarkDir.relativeTo(outputFile.absoluteFile.parentFile).invariantSeparatorsPath
+        val content = buildString {
+            append(lineCommentCopyrightHeader("//"))
+            appendLine()
+            appendLine("buildscript {")
+            appendLine("    repositories {")
+            appendLine("        gradlePluginPortal()")
+            appendLine("    }")
+            appendLine("    dependencies {")
+            appendLine("        classpath(\"me.champeau.jmh:jmh-gradle-plugin:0.7.2\")")
+            appendLine("    }")
+            appendLine("}")
+            appendLine()
+            appendLine("// The jmh source set and its extension are only created on top of the java plugin")
+            appendLine("apply(plugin = \"java\")")
+            appendLine("apply<me.champeau.jmh.JMHPlugin>()")
+            appendLine()
+            appendLine("// Kotlin compiles the .kt files found in the Java source directories as well")
+            appendLine("configure<SourceSetContainer> {")
+            appendLine("    named(\"jmh\") {")
+            appendLine("        java.srcDir(File(buildscript.sourceFile!!.parentFile, \"$relativeDir\"))")
+            appendLine("    }")
+            appendLine("}")
+            appendLine()
+            appendLine("configure<me.champeau.jmh.JmhParameters> {")
+            appendLine("    profilers.add(\"gc\")")
+            appendLine("    resultFormat.set(\"JSON\")")
+            appendLine("}")
+        }
+
+        writeIfChanged(outputFile, content)
+        return listOf(outputFile)
+    }
+
+    private fun propertyPrefix(message: ParsedMessage): String = message.name.replaceFirstChar { it.lowercase() }
+
+    private fun jmhAnnotation(name: String, value: CodeBlock): AnnotationSpec =
+        AnnotationSpec.builder(ClassName(JMH_PACKAGE, name)).addMember(value).build()
+
+    private fun stateProperty(name: String, type: TypeName): PropertySpec =
+        PropertySpec.builder(name, type, KModifier.PRIVATE, KModifier.LATEINIT).mutable().build()
+
+    private fun buildSetUp(messages: List<ParsedMessage>): FunSpec =
+        FunSpec.builder("setUp")
+            .addAnnotation(ClassName(JMH_PACKAGE, "Setup"))
+            .apply {
+                messages.forEach { message ->
+                    val prefix = propertyPrefix(message)
+                    addStatement("%LProto = sample%L(%L)", prefix, message.name, populateDepth)
+                    addStatement("%LNative = %LProto.toNative()", prefix, prefix)
+                    addStatement("%LBytes = %LProto.toByteArray()", prefix, prefix)
+                }
+            }
+            .build()
+
+    private fun TypeSpec.Builder.addBenchmarks(message: ParsedMessage, kotlinPackage: String) {
+        val prefix = propertyPrefix(message)
+        val protoClassName = ClassName(kotlinPackage, message.name)
+
+        fun benchmark(name: String, returns: TypeName, format: String, vararg args: Any) = addFunction(
+            FunSpec.builder("$prefix$name")
+                .addAnnotation(ClassName(JMH_PACKAGE, "Benchmark"))
+                .returns(returns)
+                .addStatement("return $format", *args)
+                .build()
+        )
+
+        benchmark("ToProto", protoClassName, "%LNative.toProto()", prefix)
+        benchmark("ToNative", protoClassName, "%LProto.toNative()", prefix)
+        benchmark("ToByteArray", BYTE_ARRAY, "%LProto.toByteArray()", prefix)
+        benchmark("ParseFrom", protoClassName, "%T.parseFrom(%LBytes)", protoClassName, prefix)
+    }
+
+    private fun buildSample(message: ParsedMessage, kotlinPackage: String, enums: Map<String, ParsedEnum>): FunSpec {
+        val protoClassName = ClassName(kotlinPackage, message.name)
+        val body = CodeBlock.builder()
+            .addStatement("val builder = %T.newBuilder()", protoClassName)
+        // Only the first member of a oneof can be set at a time
+        (message.fields + message.oneofs.mapNotNull { it.fields.firstOrNull() }).forEach { field ->
+            val suffix = field.name.replaceFirstChar { it.uppercase() }
+            val value = when {
+                field.isMessage -> CodeBlock.of("sample%L(depth - 1)", field.type)
+                else -> sampleValue(field, kotlinPackage, enums) ?: return@forEach
+            }
+            val setter = if (field.isRepeated) {
+                CodeBlock.of("repeat(%L) { builder.add%L(%L) }", repeatedCount, suffix, value)
+            } else {
+                CodeBlock.of("builder.set%L(%L)", suffix, value)
+            }
+            if (field.isMessage) body.addStatement("if (depth > 0) %L", setter) else body.addStatement("%L", setter)
+        }
+        body.addStatement("return builder.build()")
+
+        return FunSpec.builder("sample${message.name}")
+            .addModifiers(KModifier.PRIVATE)
+            .addParameter("depth", Int::class)
+            .returns(protoClassName)
+            .addCode(body.build())
+            .build()
+    }
+
+    /** A value that differs from the proto default, so the field is serialized. */
+    private fun sampleValue(field: ParsedField, kotlinPackage: String, enums: Map<String, ParsedEnum>): CodeBlock? {
+        if (field.isEnum) {
+            val enum = enums[field.typeName.removePrefix(".")] ?: return null
+            val value = enum.values.lastOrNull() ?: return null
+            return CodeBlock.of("%T.%L", ClassName(kotlinPackage, enum.name), value.name)
+        }
+        return when (field.type) {
+            "string" -> CodeBlock.of("%S", "benchmark sample text")
+            "bytes" -> CodeBlock.of("%T.copyFrom(ByteArray(1024) { 0x5a })", ClassName("com.google.protobuf", "ByteString"))
+            "bool" -> CodeBlock.of("true")
+            "float" -> CodeBlock.of("1.5f")
+            "double" -> CodeBlock.of("1.5")
+            "int32", "uint32" -> CodeBlock.of("123456")
+            "int64", "uint64" -> CodeBlock.of("123456L")
+            else -> null
+        }
+    }
+}
@@ -1,61 +1,500 @@
 package com.tomtom.sdk.tools.bindingsgenerator
 
+import com.squareup.kotlinpoet.ANY
+import com.squareup.kotlinpoet.ARRAY
 import com.squareup.kotlinpoet.AnnotationSpec
 import com.squareup.kotlinpoet.ClassName
 import com.squareup.kotlinpoet.CodeBlock
 import com.squareup.kotlinpoet.FileSpec
 import com.squareup.kotlinpoet.FunSpec
+import com.squareup.kotlinpoet.KModifier
+import com.squareup.kotlinpoet.LIST
+import com.squareup.kotlinpoet.LONG
+import com.squareup.kotlinpoet.LambdaTypeName
+import com.squareup.kotlinpoet.MemberName
+import com.squareup.kotlinpoet.ParameterSpec
 import com.squareup.kotlinpoet.ParameterizedTypeName.Companion.parameterizedBy
+import com.squareup.kotlinpoet.PropertySpec
+import com.squareup.kotlinpoet.TypeSpec
+import com.squareup.kotlinpoet.TypeVariableName
+import com.squareup.kotlinpoet.UNIT
 import java.io.File
-import java.time.Year
 
-private fun copyrightHeader() = """
-© ${Year.now().value} TomTom NV. All rights reserved.
+/** Initial capacity of the direct buffers in the generated JNI bindings; they grow on demand. */
+private const val NATIVE_BUFFER_CAPACITY = 64 * 1024
 
-This software is the proprietary copyright of TomTom NV and its subsidiaries and may be
-used for internal evaluation purposes or commercial use strictly subject to separate
-license agreement between you and TomTom NV. If you are the licensee, you are only permitted
-to use this software in accordance with the terms of your license agreement. If you are
-not the licensee, you are not authorized to use this software in any manner and should
-immediately return or destroy it.
+private val byteBufferClassName = ClassName("java.nio", "ByteBuffer")
 
-AUTO-GENERATED FILE. DO NOT MODIFY.
-""".trimStart()
+private const val LAZY_MAPPED_LIST = "LazyMappedList"
 
-class KotlinGenerator {
+/** Native Kotlin type of a singular `bytes` field. */
+enum class BytesMapping {
+    /** Pass the protobuf `ByteString` through in both directions. */
+    BYTE_STRING,
 
-    fun generateMapper(parsedFile: ParsedProtoFile, outputDir: File) {
+    /** Copy into a `ByteArray` with `toByteArray()`, and back with `ByteString.copyFrom`. */
+    BYTE_ARRAY,
+
+    /**
+     * View the `ByteString` through `asReadOnlyByteBuffer()`, and wrap the buffer back with
+     * `UnsafeByteOperations.unsafeWrap`. Neither direction copies, so the buffer must not change afterwards.
+     */
+    READ_ONLY_BYTE_BUFFER
+}
+
+/**
+ * Configuration for the Kotlin generator.
+ *
+ * @param allocationFreeMappers Emit message mappers that fill a plain `newBuilder()` and call the native
+ *   constructor, instead of the DSL builders. Repeated scalars are handed over without copying, and repeated
+ *   enums and messages are converted in indexed loops into pre-sized lists, so a conversion allocates only
+ *   the objects it returns. Defaults to false.
+ * @param enumLookupTables Convert enums through arrays built once in a private object: native to proto indexed
+ *   by `ordinal`, proto to native indexed by `number`. Values without a mapping still throw
+ *   `IllegalArgumentException`. Proto enums whose numbers are negative or too sparse for an array keep the
+ *   `when` in that direction. Defaults to false.
+ * @param lazyRepeatedMessages Map repeated message fields in `toNative()` to a `LazyMappedList`, which converts
+ *   an element when it is first read instead of converting the whole list up front. Defaults to false.
+ * @param cacheLazyElements Keep the elements a `LazyMappedList` has converted, so reading one again returns the
+ *   same object. Without it every read converts again and nothing is retained. Defaults to true.
+ * @param bytesMapping How singular `bytes` fields are mapped, see [BytesMapping]. Defaults to
+ *   [BytesMapping.BYTE_STRING].
+ * @param bytesFieldMappings Per-field overrides of [bytesMapping], keyed by proto field name (`data_png`) or by
+ *   message and field name (`JunctionViewInformation.data_png`). Defaults to empty.
+ * @param emitSuspendClient Also give `Native<Service>Client` a `suspend` variant of every rpc. It serializes,
+ *   calls the native side and parses on a dispatcher that runs at most [suspendParallelism] calls at once. The
+ *   native call itself cannot be interrupted, but a caller cancelled meanwhile skips parsing the response. The
+ *   generated code then needs kotlinx-coroutines. Defaults to false.
+ * @param suspendParallelism Default parallelism of the client's dispatcher when [emitSuspendClient] is set.
+ *   Defaults to 4.
+ * @param clientPoolSize Number of idle `<Service>Jni` instances, each holding a request and a response direct
+ *   buffer, that `Native<Service>Client` keeps for later calls. Calls beyond that create their own instance.
+ *   Defaults to 4.
+ * @param clientMaxRetainedBytes Largest combined buffer capacity of an instance the client keeps; one that grew
+ *   past it for a large payload is dropped after the call. Defaults to 1 MiB.
+ */
+data class KotlinGeneratorConfig(
+    val allocationFreeMappers: Boolean = false,
+    val enumLookupTables: Boolean = false,
+    val lazyRepeatedMessages: Boolean = false,
+    val cacheLazyElements: Boolean = true,
+    val bytesMapping: BytesMapping = BytesMapping.BYTE_STRING,
+    val bytesFieldMappings: Map<String, BytesMapping> = emptyMap(),
+    val emitSuspendClient: Boolean = false,
+    val suspendParallelism: Int = 4,
+    val clientPoolSize: Int = 4,
+    val clientMaxRetainedBytes: Int = 1024 * 1024
+) {
+    companion object {
+        val DEFAULT = KotlinGeneratorConfig()
+    }
+}
+
+class KotlinGenerator(private val config: KotlinGeneratorConfig = KotlinGeneratorConfig.DEFAULT) {
+
+    fun generateMapper(parsedFile: ParsedProtoFile, outputDir: File): List<File> {
         val kotlinPackage = getKotlinPackageName(parsedFile.protoPackage)
         val fileName = "NativeModelMapper"
 
         val fileSpec = FileSpec.builder(kotlinPackage, fileName)
-            .addFileComment(copyrightHeader())
+            .addFileComment(kotlinFileComment())
             .addAnnotation(
                 AnnotationSpec.builder(Suppress::class)
                     .addMember("%S", "detekt:TooManyFunctions")
                     .build()
             )
             .apply {
+                if (config.lazyRepeatedMessages) {
+                    addType(buildLazyMappedListClass())
+                }
                 addEnumExtensions(parsedFile.enums, parsedFile.protoPackage)
                 addMessageExtensions(parsedFile.messages, parsedFile.protoPackage, parsedFile.enums)
             }
             .build()
 
         outputDir.mkdirs()
-        fileSpec.writeTo(outputDir)
         // Post-process: add plain @Suppress annotation for compatibility (in addition to @file:Suppress)
-        val generatedFile = outputDir.walkTopDown().find { it.name == "$fileName.kt" }
-        generatedFile?.let { file ->
-            val content = file.readText()
-            if (!content.contains("\n@Suppress(")) {
-                file.writeText(content.replace(
+        val content = fileSpec.toString()
+        val file = fileSpec.writeToIfChanged(
+            outputDir,
+            if (content.contains("\n@Suppress(")) {
+                content
+            } else {
+                content.replace(
                     "@file:Suppress(\"detekt:TooManyFunctions\")",
                     "@file:Suppress(\"detekt:TooManyFunctions\")\n@Suppress(\"detekt:TooManyFunctions\")"
-                ))
+                )
+            }
+        )
+        return listOf(file)
+    }
+
+    /**
+     * Writes a `<Service>Jni` class per service, holding the `external` declarations that match the
+     * entry points from [JniGenerator]. Each instance owns a request and a response direct `ByteBuffer`
+     * that are reused across calls and only grow, so an instance must not be shared between threads.
+     * Loading the native library is left to the caller.
+     */
+    fun generateNativeBindings(parsedFile: ParsedProtoFile, outputDir: File): List<File> {
+        val kotlinPackage = getKotlinPackageName(parsedFile.protoPackage)
+        outputDir.mkdirs()
+        return parsedFile.services.map { service ->
+            FileSpec.builder(kotlinPackage, JniGenerator.bindingsClassName(service))
+                .addFileComment(kotlinFileComment())
+                .addType(buildNativeBindingsClass(service, parsedFile.protoPackage))
+                .build()
+                .writeToIfChanged(outputDir)
+        }
+    }
+
+    private fun buildNativeBindingsClass(service: ParsedService, protoPackage: String): TypeSpec {
+        fun bufferProperty(name: String) = PropertySpec.builder(name, byteBufferClassName, KModifier.PRIVATE)
+            .mutable()
+            .initializer("%T.allocateDirect(initialCapacity)", byteBufferClassName)
+            .build()
+
+        return TypeSpec.classBuilder(JniGenerator.bindingsClassName(service))
+            .addKdoc("JNI bindings for %L. Not thread-safe: the request and response buffers are reused.", service.name)
+            .addModifiers(KModifier.INTERNAL)
+            .primaryConstructor(
+                FunSpec.constructorBuilder()
+                    .addParameter(
+                        ParameterSpec.builder("initialCapacity", Int::class)
+                            .defaultValue("%L", NATIVE_BUFFER_CAPACITY)
+                            .build()
+                    )
+                    .build()
+            )
+            .addProperty(bufferProperty("requestBuffer"))
+            .addProperty(bufferProperty("responseBuffer"))
+            .addProperty(
+                PropertySpec.builder("retainedBytes", Int::class)
+                    .addKdoc("Capacity of the request and response buffers, which only grow.")
+                    .getter(FunSpec.getterBuilder().addStatement("return requestBuffer.capacity() + responseBuffer.capacity()").build())
+                    .build()
+            )
+            .apply {
+                service.methods.forEach { method ->
+                    addFunction(buildNativeCallFun(method, protoPackage))
+                    addFunction(buildNativeRawCallFun(method, protoPackage))
+                    addFunction(
+                        FunSpec.builder(JniGenerator.nativeMethodName(method))
+                            .addModifiers(KModifier.PRIVATE, KModifier.EXTERNAL)
+                            .addParameter("handle", Long::class)
+                            .addParameter("request", byteBufferClassName)
+                            .addParameter("requestSize", Int::class)
+                            .addParameter("response", byteBufferClassName)
+                            .returns(byteBufferClassName)
+                            .build()
+                    )
+                }
             }
+            .build()
+    }
+
+    private fun buildNativeCallFun(method: ParsedMethod, protoPackage: String): FunSpec {
+        val responseClassName = getProtoClassName(method.outputType, protoPackage)
+
+        return FunSpec.builder(JniGenerator.kotlinMethodName(method))
+            .addParameter("handle", Long::class)
+            .addParameter("request", getProtoClassName(method.inputType, protoPackage))
+            .returns(responseClassName)
+            .addStatement("%L(handle, request)", getRawCallName(method))
+            .addStatement("return %T.parseFrom(responseBuffer)", responseClassName)
+            .build()
+    }
+
+    private fun getRawCallName(method: ParsedMethod): String = "call${method.name}"
+
+    /** Serializes the request and calls the native side, leaving the response unparsed. */
+    private fun buildNativeRawCallFun(method: ParsedMethod, protoPackage: String): FunSpec {
+        val bodyCode = CodeBlock.builder()
+            .addStatement("val requestSize = request.serializedSize")
+            .beginControlFlow("if (requestBuffer.capacity() < requestSize)")
+            .addStatement("requestBuffer = %T.allocateDirect(requestSize)", byteBufferClassName)
+            .endControlFlow()
+            .addStatement("requestBuffer.clear()")
+            .addStatement("val output = %T.newInstance(requestBuffer)", ClassName("com.google.protobuf", "CodedOutputStream"))
+            .addStatement("request.writeTo(output)")
+            .addStatement("output.flush()")
+            .addStatement("responseBuffer.clear()")
+            .add("// The native side returns a larger buffer when the response does not fit; keep it for later calls\n")
+            .addStatement(
+                "responseBuffer = %L(handle, requestBuffer, requestSize, responseBuffer)",
+                JniGenerator.nativeMethodName(method)
+            )
+            .addStatement("return responseBuffer")
+            .build()
+
+        return FunSpec.builder(getRawCallName(method))
+            .addKdoc("Returns the encoded response, which stays valid until the next call on this instance.")
+            .addParameter("handle", Long::class)
+            .addParameter("request", getProtoClassName(method.inputType, protoPackage))
+            .returns(byteBufferClassName)
+            .addCode(bodyCode)
+            .build()
+    }
+
+    /**
+     * Writes a `Native<Service>Client` class per service on top of the bindings from
+     * [generateNativeBindings]. Calls only take the read side of a `ReentrantReadWriteLock`, so requests
+     * from several threads run concurrently; replacing or closing the handle takes the write side and
+     * waits for the calls in flight. A call borrows a `<Service>Jni` from a pool of at most
+     * [KotlinGeneratorConfig.clientPoolSize] idle instances, so buffers are never shared and pooled threads do
+     * not each pin their own. `replaceHandle` and `close` empty the pool. The caller creates native handles and
+     * passes the function that destroys them.
+     */
+    fun generateNativeClient(parsedFile: ParsedProtoFile, outputDir: File): List<File> {
+        val kotlinPackage = getKotlinPackageName(parsedFile.protoPackage)
+        outputDir.mkdirs()
+        return parsedFile.services.map { service ->
+            FileSpec.builder(kotlinPackage, getNativeClientName(service))
+                .addFileComment(kotlinFileComment())
+                .addType(buildNativeClientClass(service, kotlinPackage, parsedFile.protoPackage))
+                .build()
+                .writeToIfChanged(outputDir)
         }
     }
 
+    private fun buildNativeClientClass(service: ParsedService, kotlinPackage: String, protoPackage: String): TypeSpec {
+        val bindingsClassName = ClassName(kotlinPackage, JniGenerator.bindingsClassName(service))
+        val lockClassName = ClassName("java.util.concurrent.locks", "ReentrantReadWriteLock")
+        val read = MemberName("kotlin.concurrent", "read")
+        val write = MemberName("kotlin.concurrent", "write")
+        val destroyHandleType = LambdaTypeName.get(null, LONG, returnType = UNIT)
+
+        val replaceHandleFun = FunSpec.builder("replaceHandle")
+            .addKdoc("Takes ownership of [newHandle] and destroys the previous handle once no call is using it.")
+            .addParameter("newHandle", Long::class)
+            .beginControlFlow("handleLock.%M", write)
+            .addStatement("if (handle != 0L) destroyHandle(handle)")
+            .addStatement("handle = newHandle")
+            .addStatement("bindingsPool.clear()")
+            .endControlFlow()
+            .build()
+
+        val closeFun = FunSpec.builder("close")
+            .addModifiers(KModifier.OVERRIDE)
+            .beginControlFlow("handleLock.%M", write)
+            .beginControlFlow("if (handle != 0L)")
+            .addStatement("destroyHandle(handle)")
+            .addStatement("handle = 0L")
+            .endControlFlow()
+            .addStatement("bindingsPool.clear()")
+            .endControlFlow()
+            .build()
+
+        val poolClassName = ClassName("java.util.concurrent", "ArrayBlockingQueue").parameterizedBy(bindingsClassName)
+        val acquireBindingsFun = FunSpec.builder("acquireBindings")
+            .addModifiers(KModifier.PRIVATE)
+            .returns(bindingsClassName)
+            .addStatement("return bindingsPool.poll() ?: %T()", bindingsClassName)
+            .build()
+        val releaseBindingsFun = FunSpec.builder("releaseBindings")
+            .addKdoc(
+                "Keeps [bindings] for a later call unless the client is closed, the pool is full or its buffers " +
+                    "grew past %L bytes.",
+                config.clientMaxRetainedBytes
+            )
+            .addModifiers(KModifier.PRIVATE)
+            .addParameter("bindings", bindingsClassName)
+            .beginControlFlow("handleLock.%M", read)
+            .addStatement(
+                "if (handle != 0L && bindings.retainedBytes <= %L) bindingsPool.offer(bindings)",
+                config.clientMaxRetainedBytes
+            )
+            .endControlFlow()
+            .build()
+
+        val dispatcherClassName = ClassName("kotlinx.coroutines", "CoroutineDispatcher")
+
+        return TypeSpec.classBuilder(getNativeClientName(service))
+            .addKdoc("Native client for %L. Calls return null once the client has been closed.", service.name)
+            .addModifiers(KModifier.INTERNAL)
+            .addSuperinterface(AutoCloseable::class)
+            .apply {
+                if (config.emitSuspendClient) {
+                    addAnnotation(
+                        AnnotationSpec.builder(ClassName("kotlin", "OptIn"))
+                            .addMember("%T::class", ClassName("kotlinx.coroutines", "ExperimentalCoroutinesApi"))
+                            .build()
+                    )
+                }
+            }
+            .primaryConstructor(
+                FunSpec.constructorBuilder()
+                    .addParameter("destroyHandle", destroyHandleType)
+                    .apply {
+                        if (config.emitSuspendClient) {
+                            addParameter(
+                                ParameterSpec.builder("dispatcher", dispatcherClassName)
+                                    .defaultValue(
+                                        "%T.IO.limitedParallelism(%L)",
+                                        ClassName("kotlinx.coroutines", "Dispatchers"),
+                                        config.suspendParallelism
+                                    )
+                                    .build()
+                            )
+                        }
+                    }
+                    .build()
+            )
+            .apply {
+                if (config.emitSuspendClient) {
+                    addProperty(
+                        PropertySpec.builder("dispatcher", dispatcherClassName, KModifier.PRIVATE)
+                            .initializer("dispatcher")
+                            .build()
+                    )
+                }
+            }
+            .addProperty(
+                PropertySpec.builder("destroyHandle", destroyHandleType, KModifier.PRIVATE)
+                    .initializer("destroyHandle")
+                    .build()
+            )
+            .addProperty(
+                PropertySpec.builder("handleLock", lockClassName, KModifier.PRIVATE)
+                    .initializer("%T()", lockClassName)
+                    .build()
+            )
+            .addProperty(
+                PropertySpec.builder("handle", Long::class, KModifier.PRIVATE)
+                    .mutable()
+                    .initializer("0L")
+                    .build()
+            )
+            .addProperty(
+                PropertySpec.builder("bindingsPool", poolClassName, KModifier.PRIVATE)
+                    .initializer("%T(%L)", poolClassName, config.clientPoolSize)
+                    .build()
+            )
+            .addFunction(replaceHandleFun)
+            .addFunction(acquireBindingsFun)
+            .addFunction(releaseBindingsFun)
+            .apply {
+                service.methods.forEach { method ->
+                    val requestClassName = getProtoClassName(method.inputType, protoPackage)
+                    val responseClassName = getProtoClassName(method.outputType, protoPackage)
+                    addFunction(
+                        FunSpec.builder(JniGenerator.kotlinMethodName(method))
+                            .addParameter("request", requestClassName)
+                            .returns(responseClassName.copy(nullable = true))
+                            .beginControlFlow("return handleLock.%M", read)
+                            .addStatement("if (handle == 0L) return null")
+                            .addStatement("val bindings = acquireBindings()")
+                            .beginControlFlow("try")
+                            .addStatement("bindings.%L(handle, request)", JniGenerator.kotlinMethodName(method))
+                            .nextControlFlow("finally")
+                            .addStatement("releaseBindings(bindings)")
+                            .endControlFlow()
+                            .endControlFlow()
+                            .build()
+                    )
+                    if (config.emitSuspendClient) {
+                        addFunction(buildSuspendCallFun(method, protoPackage))
+                    }
+                }
+            }
+            .addFunction(closeFun)
+            .build()
+    }
+
+    private fun buildSuspendCallFun(method: ParsedMethod, protoPackage: String): FunSpec {
+        val responseClassName = getProtoClassName(method.outputType, protoPackage)
+
+        val bodyCode = CodeBlock.builder()
+            .beginControlFlow("return %M(dispatcher)", MemberName("kotlinx.coroutines", "withContext"))
+            .add("// Borrowed until the response is parsed, since it lives in the instance's buffer\n")
+            .addStatement("val bindings = acquireBindings()")
+            .beginControlFlow("try")
+            .beginControlFlow("val response = handleLock.%M", MemberName("kotlin.concurrent", "read"))
+            .addStatement("if (handle != 0L) bindings.%L(handle, request) else null", getRawCallName(method))
+            .endControlFlow()
+            .addStatement("if (response == null) return@withContext null")
+            .add("// The native call cannot be interrupted; a caller that has gone away skips the parse\n")
+            .addStatement("%M()", MemberName("kotlinx.coroutines", "ensureActive"))
+            .addStatement("%T.parseFrom(response)", responseClassName)
+            .nextControlFlow("finally")
+            .addStatement("releaseBindings(bindings)")
+            .endControlFlow()
+            .endControlFlow()
+            .build()
+
+        return FunSpec.builder("${JniGenerator.kotlinMethodName(method)}Suspending")
+            .addModifiers(KModifier.SUSPEND)
+            .addParameter("request", getProtoClassName(method.inputType, protoPackage))
+            .returns(responseClassName.copy(nullable = true))
+            .addCode(bodyCode)
+            .build()
+    }
+
+    private fun getNativeClientName(service: ParsedService): String = "Native${service.name}Client"
+
+    /** Java class of a fully qualified proto type name such as `.pkg.Outer.Inner`. */
+    private fun getProtoClassName(typeName: String, protoPackage: String): ClassName {
+        val prefix = ".$protoPackage."
+        return if (typeName.startsWith(prefix)) {
+            ClassName(protoPackage, typeName.removePrefix(prefix).split("."))
+        } else {
+            ClassName(typeName.removePrefix(".").substringBeforeLast('.'), typeName.substringAfterLast('.'))
+        }
+    }
+
+    private fun buildLazyMappedListClass(): TypeSpec {
+        val source = TypeVariableName("S")
+        val target = TypeVariableName("T")
+        val transformType = LambdaTypeName.get(null, source, returnType = target)
+
+        return TypeSpec.classBuilder(LAZY_MAPPED_LIST)
+            .addKdoc(
+                "Read-only view of [source] that converts an element with [transform] when it is read. With [cache] " +
+                    "the result is kept, so later reads return the same object. Concurrent first reads may convert " +
+                    "an element more than once, which is harmless because conversions have no side effects.\n"
+            )
+            .addModifiers(KModifier.INTERNAL)
+            .addTypeVariable(source)
+            .addTypeVariable(target)
+            .superclass(ClassName("kotlin.collections", "AbstractList").parameterizedBy(target))
+            .addSuperinterface(ClassName("kotlin.collections", "RandomAccess"))
+            .primaryConstructor(
+                FunSpec.constructorBuilder()
+                    .addParameter("source", LIST.parameterizedBy(source))
+                    .addParameter("cache", Boolean::class)
+                    .addParameter("transform", transformType)
+                    .build()
+            )
+            .addProperty(PropertySpec.builder("source", LIST.parameterizedBy(source), KModifier.PRIVATE).initializer("source").build())
+            .addProperty(PropertySpec.builder("transform", transformType, KModifier.PRIVATE).initializer("transform").build())
+            .addProperty(
+                PropertySpec.builder("converted", ARRAY.parameterizedBy(ANY.copy(nullable = true)).copy(nullable = true), KModifier.PRIVATE)
+                    .initializer("if (cache) arrayOfNulls(source.size) else null")
+                    .build()
+            )
+            .addProperty(
+                PropertySpec.builder("size", Int::class, KModifier.OVERRIDE)
+                    .getter(FunSpec.getterBuilder().addStatement("return source.size").build())
+                    .build()
+            )
+            .addFunction(
+                FunSpec.builder("get")
+                    .addAnnotation(AnnotationSpec.builder(Suppress::class).addMember("%S", "UNCHECKED_CAST").build())
+                    .addModifiers(KModifier.OVERRIDE)
+                    .addParameter("index", Int::class)
+                    .returns(target)
+                    .addStatement("val slots = converted ?: return transform(source[index])")
+                    .addStatement("val cached = slots[index]")
+                    .addStatement("if (cached != null) return cached as %T", target)
+                    .addStatement("return transform(source[index]).also { slots[index] = it }")
+                    .build()
+            )
+            .build()
+    }
+
+    /** `LazyMappedList` over [list] that converts elements with `toNative()`. */
+    private fun lazyToNative(list: String): CodeBlock =
+        CodeBlock.of("%L(%L, %L) { it.toNative() }", LAZY_MAPPED_LIST, list, config.cacheLazyElements)
+
     private fun getKotlinPackageName(protoPackage: String): String {
         return protoPackage
     }
@@ -65,11 +504,66 @@ class KotlinGenerator {
         protoPackage: String
     ) {
         enums.forEach { enum ->
+            if (config.enumLookupTables) {
+                addType(buildEnumTablesObject(enum, protoPackage))
+            }
             addFunction(buildToProtoEnumFun(enum, protoPackage))
             addFunction(buildToNativeEnumFun(enum, protoPackage))
         }
     }
 
+    private fun getEnumTablesName(enum: ParsedEnum): String = "${enum.name}Tables"
+
+    /** Whether proto numbers of [enum] can index an array without wasting much of it. */
+    private fun hasDenseNumbers(enum: ParsedEnum): Boolean =
+        enum.values.isNotEmpty() && enum.values.all { it.number >= 0 } && enum.values.maxOf { it.number } < 2 * enum.values.size
+
+    private fun buildEnumTablesObject(enum: ParsedEnum, protoPackage: String): TypeSpec {
+        val nativeClassName = getNativeEnumClassName(enum, protoPackage)
+        val protoClassName = ClassName(protoPackage, enum.name)
+
+        val byOrdinal = CodeBlock.builder()
+            .beginControlFlow("arrayOfNulls<%T>(%T.values().size).apply", protoClassName, nativeClassName)
+            .apply {
+                enum.values.forEach { value ->
+                    val nativeValue = convertEnumValueToNative(value.name, enum.name)
+                    addStatement("this[%T.%L.ordinal] = %T.%L", nativeClassName, nativeValue, protoClassName, value.name)
+                }
+            }
+            .unindent()
+            .add("}")
+            .build()
+
+        return TypeSpec.objectBuilder(getEnumTablesName(enum))
+            .addModifiers(KModifier.PRIVATE)
+            .addProperty(
+                PropertySpec.builder("protoByNativeOrdinal", ARRAY.parameterizedBy(protoClassName.copy(nullable = true)))
+                    .initializer(byOrdinal)
+                    .build()
+            )
+            .apply {
+                if (!hasDenseNumbers(enum)) return@apply
+                // Aliases share a number; the first one listed wins, as in the when form
+                val byNumber = CodeBlock.builder()
+                    .beginControlFlow("arrayOfNulls<%T>(%L).apply", nativeClassName, enum.values.maxOf { it.number } + 1)
+                    .apply {
+                        enum.values.distinctBy { it.number }.forEach { value ->
+                            val nativeValue = convertEnumValueToNative(value.name, enum.name)
+                            addStatement("this[%L] = %T.%L", value.number, nativeClassName, nativeValue)
+                        }
+                    }
+                    .unindent()
+                    .add("}")
+                    .build()
+                addProperty(
+                    PropertySpec.builder("nativeByProtoNumber", ARRAY.parameterizedBy(nativeClassName.copy(nullable = true)))
+                        .initializer(byNumber)
+                        .build()
+                )
+            }
+            .build()
+    }
+
     private fun FileSpec.Builder.addMessageExtensions(
         messages: List<ParsedMessage>,
         protoPackage: String,
@@ -88,6 +582,17 @@ class KotlinGenerator {
         val nativeClassName = getNativeEnumClassName(enum, protoPackage)
         val protoClassName = ClassName(protoPackage, enum.name)
 
+        if (config.enumLookupTables) {
+            return FunSpec.builder("toProto")
+                .receiver(nativeClassName)
+                .returns(protoClassName)
+                .addStatement(
+                    "return %L.protoByNativeOrdinal[ordinal] ?: throw %T(%S + this)",
+                    getEnumTablesName(enum), IllegalArgumentException::class, "Unexpected value "
+                )
+                .build()
+        }
+
         val codeBlock = CodeBlock.builder()
             .beginControlFlow("return when (this)")
             .apply {
@@ -111,6 +616,18 @@ class KotlinGenerator {
         val nativeClassName = getNativeEnumClassName(enum, protoPackage)
         val protoClassName = ClassName(protoPackage, enum.name)
 
+        if (config.enumLookupTables && hasDenseNumbers(enum)) {
+            // getNumber() of UNRECOGNIZED throws IllegalArgumentException itself
+            return FunSpec.builder("toNative")
+                .receiver(protoClassName)
+                .returns(nativeClassName)
+                .addStatement(
+                    "return %L.nativeByProtoNumber.getOrNull(number) ?: throw %T(%S + this)",
+                    getEnumTablesName(enum), IllegalArgumentException::class, "Unexpected value "
+                )
+                .build()
+        }
+
         val codeBlock = CodeBlock.builder()
             .beginControlFlow("return when (this)")
             .apply {
@@ -135,6 +652,8 @@ class KotlinGenerator {
         protoPackage: String,
         knownEnums: List<ParsedEnum>
     ): FunSpec {
+        if (config.allocationFreeMappers) return buildToProtoBuilderFun(message, protoPackage)
+
         val nativeClassName = getNativeMessageClassName(message, protoPackage)
         val protoBuilderName = getProtoBuilderName(message, protoPackage)
 
@@ -142,7 +661,7 @@ class KotlinGenerator {
         bodyCode.beginControlFlow("return %L", protoBuilderName)
 
         message.fields.forEach { field ->
-            generateToProtoFieldMapping(bodyCode, field, protoPackage, knownEnums, "this@toProto")
+            generateToProtoFieldMapping(bodyCode, message, field, protoPackage, knownEnums, "this@toProto")
         }
         message.oneofs.forEach { oneof ->
             bodyCode.beginControlFlow("when")
@@ -169,6 +688,8 @@ class KotlinGenerator {
         protoPackage: String,
         knownEnums: List<ParsedEnum>
     ): FunSpec {
+        if (config.allocationFreeMappers) return buildToNativeConstructorFun(message, protoPackage)
+
         val nativeClassName = getNativeMessageClassName(message, protoPackage)
         val protoClassName = ClassName(protoPackage, message.name)
 
@@ -176,7 +697,7 @@ class KotlinGenerator {
         bodyCode.beginControlFlow("return %T", nativeClassName)
 
         message.fields.forEach { field ->
-            generateToNativeFieldMapping(bodyCode, field, protoPackage, knownEnums, "this@toNative")
+            generateToNativeFieldMapping(bodyCode, message, field, protoPackage, knownEnums, "this@toNative")
         }
         message.oneofs.forEach { oneof ->
             val oneofCaseClass = ClassName(protoPackage, "${message.name}.${oneof.name.replaceFirstChar { it.uppercase() }}Case")
@@ -202,8 +723,99 @@ class KotlinGenerator {
             .build()
     }
 
+    /** [buildToProtoMessageFun] for [KotlinGeneratorConfig.allocationFreeMappers]. */
+    private fun buildToProtoBuilderFun(message: ParsedMessage, protoPackage: String): FunSpec {
+        val protoClassName = ClassName(protoPackage, message.name)
+
+        val bodyCode = CodeBlock.builder()
+            .addStatement("val builder = %T.newBuilder()", protoClassName)
+        message.fields.forEach { field ->
+            val suffix = field.name.replaceFirstChar { it.uppercase() }
+            when {
+                field.isRepeated && !field.isEnum && !field.isMessage ->
+                    bodyCode.addStatement("builder.addAll%L(this.%L)", suffix, field.name)
+                field.isRepeated ->
+                    bodyCode.addStatement(
+                        "for (i in this.%L.indices) builder.add%L(%L)",
+                        field.name, suffix, protoValue(message, field, "this.${field.name}[i]")
+                    )
+                field.isOptional ->
+                    bodyCode.addStatement("this.%L?.let { builder.set%L(%L) }", field.name, suffix, protoValue(message, field, "it"))
+                else ->
+                    bodyCode.addStatement("builder.set%L(%L)", suffix, protoValue(message, field, "this.${field.name}"))
+            }
+        }
+        message.oneofs.forEach { oneof ->
+            bodyCode.beginControlFlow("when")
+            oneof.fields.forEach { field ->
+                bodyCode.addStatement(
+                    "this.%L != null -> builder.set%L(%L)",
+                    field.name, field.name.replaceFirstChar { it.uppercase() }, protoValue(message, field, "this.${field.name}!!")
+                )
+            }
+            bodyCode.endControlFlow()
+        }
+        bodyCode.addStatement("return builder.build()")
+
+        return FunSpec.builder("toProto")
+            .receiver(getNativeMessageClassName(message, protoPackage))
+            .returns(protoClassName)
+            .addCode(bodyCode.build())
+            .build()
+    }
+
+    /** [buildToNativeMessageFun] for [KotlinGeneratorConfig.allocationFreeMappers]. */
+    private fun buildToNativeConstructorFun(message: ParsedMessage, protoPackage: String): FunSpec {
+        val nativeClassName = getNativeMessageClassName(message, protoPackage)
+        val protoClassName = ClassName(protoPackage, message.name)
+
+        val bodyCode = CodeBlock.builder()
+        // Converted repeated fields are filled before the constructor call, into lists sized up front
+        message.fields.filter { it.isRepeated && (it.isEnum || it.isMessage) && !isLazyField(it) }.forEach { field ->
+            bodyCode.addStatement("val %LProto = this.%LList", field.name, field.name)
+            bodyCode.addStatement(
+                "val %LNative = %T<%T>(%LProto.size)",
+                field.name, ClassName("kotlin.collections", "ArrayList"), getNativeElementClassName(field, protoPackage), field.name
+            )
+            bodyCode.addStatement("for (i in %LProto.indices) %LNative.add(%LProto[i].toNative())", field.name, field.name, field.name)
+        }
+
+        bodyCode.add("return %T(\n", nativeClassName).indent()
+        message.fields.forEach { field ->
+            val suffix = field.name.replaceFirstChar { it.uppercase() }
+            val value = nativeValue(message, field, "this.${field.name}")
+            when {
+                field.isRepeated && !field.isEnum && !field.isMessage -> bodyCode.add("%L = this.%LList,\n", field.name, field.name)
+                isLazyField(field) -> bodyCode.add("%L = %L,\n", field.name, lazyToNative("this.${field.name}List"))
+                field.isRepeated -> bodyCode.add("%L = %LNative,\n", field.name, field.name)
+                field.isOptional -> bodyCode.add("%L = if (this.has%L()) %L else null,\n", field.name, suffix, value)
+                else -> bodyCode.add("%L = %L,\n", field.name, value)
+            }
+        }
+        message.oneofs.forEach { oneof ->
+            val caseName = oneof.name.split("_").joinToString("") { it.replaceFirstChar { c -> c.uppercase() } } + "Case"
+            bodyCode.add("%L = when (this.%L) {\n", oneof.name, caseName.replaceFirstChar { it.lowercase() }).indent()
+            oneof.fields.forEach { field ->
+                bodyCode.add(
+                    "%T.%L -> %L\n",
+                    protoClassName.nestedClass(caseName), field.protoName.uppercase(),
+                    nativeValue(message, field, "this.${field.name}")
+                )
+            }
+            bodyCode.add("else -> null\n").unindent().add("},\n")
+        }
+        bodyCode.unindent().add(")\n")
+
+        return FunSpec.builder("toNative")
+            .receiver(protoClassName)
+            .returns(nativeClassName)
+            .addCode(bodyCode.build())
+            .build()
+    }
+
     private fun generateToProtoFieldMapping(
         builder: CodeBlock.Builder,
+        message: ParsedMessage,
         field: ParsedField,
         protoPackage: String,
         knownEnums: List<ParsedEnum>,
@@ -218,6 +830,18 @@ class KotlinGenerator {
                     field.name
                 )
             }
+            isMappedBytesField(message, field) && field.isOptional -> {
+                builder.addStatement(
+                    "%L.%L?.let { %L = %L }",
+                    receiver,
+                    field.name,
+                    field.protoName,
+                    protoValue(message, field, "it")
+                )
+            }
+            isMappedBytesField(message, field) -> {
+                builder.addStatement("%L = %L", field.protoName, protoValue(message, field, "$receiver.${field.name}"))
+            }
             field.isOptional && !field.isEnum && !field.isMessage -> {
                 builder.addStatement(
                     "%L.%L?.let { %L = it }",
@@ -255,12 +879,16 @@ class KotlinGenerator {
 
     private fun generateToNativeFieldMapping(
         builder: CodeBlock.Builder,
+        message: ParsedMessage,
         field: ParsedField,
         protoPackage: String,
         knownEnums: List<ParsedEnum>,
         receiver: String
     ) {
         when {
+            field.isRepeated && field.isMessage && config.lazyRepeatedMessages -> {
+                builder.addStatement("%L = %L", field.name, lazyToNative("$receiver.${field.name}List"))
+            }
             field.isRepeated -> {
                 builder.addStatement(
                     "%L = %L.%LList",
@@ -269,6 +897,18 @@ class KotlinGenerator {
                     field.protoName
                 )
             }
+            isMappedBytesField(message, field) && field.isOptional -> {
+                builder.addStatement(
+                    "%L = if (%L.has%L()) %L else null",
+                    field.name,
+                    receiver,
+                    field.protoName.split("_").joinToString("") { it.replaceFirstChar { c -> c.uppercase() } },
+                    nativeValue(message, field, "$receiver.${field.protoName}")
+                )
+            }
+            isMappedBytesField(message, field) -> {
+                builder.addStatement("%L = %L", field.name, nativeValue(message, field, "$receiver.${field.protoName}"))
+            }
             field.isOptional && !field.isEnum && !field.isMessage -> {
                 builder.addStatement(
                     "%L = if (%L.has%L()) %L.%L else null",
@@ -315,6 +955,38 @@ class KotlinGenerator {
         return ClassName(protoPackage, message.name)
     }
 
+    private fun bytesMapping(message: ParsedMessage, field: ParsedField): BytesMapping =
+        config.bytesFieldMappings["${message.name}.${field.protoName}"]
+            ?: config.bytesFieldMappings[field.protoName]
+            ?: config.bytesMapping
+
+    /** Whether a singular `bytes` field converts to something other than the `ByteString` itself. */
+    private fun isMappedBytesField(message: ParsedMessage, field: ParsedField): Boolean =
+        field.type == "bytes" && !field.isRepeated && bytesMapping(message, field) != BytesMapping.BYTE_STRING
+
+    /** Expression converting [value], one proto value of [field], to its native form. */
+    private fun nativeValue(message: ParsedMessage, field: ParsedField, value: String): CodeBlock = when {
+        field.isEnum || field.isMessage -> CodeBlock.of("%L.toNative()", value)
+        !isMappedBytesField(message, field) -> CodeBlock.of("%L", value)
+        bytesMapping(message, field) == BytesMapping.BYTE_ARRAY -> CodeBlock.of("%L.toByteArray()", value)
+        else -> CodeBlock.of("%L.asReadOnlyByteBuffer()", value)
+    }
+
+    /** Expression converting [value], one native value of [field], to its proto form. */
+    private fun protoValue(message: ParsedMessage, field: ParsedField, value: String): CodeBlock = when {
+        field.isEnum || field.isMessage -> CodeBlock.of("%L.toProto()", value)
+        !isMappedBytesField(message, field) -> CodeBlock.of("%L", value)
+        bytesMapping(message, field) == BytesMapping.BYTE_ARRAY ->
+            CodeBlock.of("%T.copyFrom(%L)", ClassName("com.google.protobuf", "ByteString"), value)
+        else -> CodeBlock.of("%T.unsafeWrap(%L)", ClassName("com.google.protobuf", "UnsafeByteOperations"), value)
+    }
+
+    private fun isLazyField(field: ParsedField): Boolean =
+        config.lazyRepeatedMessages && field.isRepeated && field.isMessage
+
+    private fun getNativeElementClassName(field: ParsedField, protoPackage: String): ClassName =
+        ClassName(protoPackage, field.typeName.substringAfterLast('.'))
+
     private fun getProtoBuilderName(message: ParsedMessage, protoPackage: String): String {
         val simpleName = message.name
             .split(".")
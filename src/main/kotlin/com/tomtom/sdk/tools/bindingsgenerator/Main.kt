@@ -1,36 +1,241 @@
 package com.tomtom.sdk.tools.bindingsgenerator
 
+import com.google.protobuf.DescriptorProtos
+import com.google.protobuf.Descriptors
 import kotlinx.cli.ArgParser
 import kotlinx.cli.ArgType
+import kotlinx.cli.default
+import kotlinx.cli.multiple
 import kotlinx.cli.required
 import java.io.File
+import java.util.concurrent.Executors
 
 fun main(args: Array<String>) {
     val parser = ArgParser("bindings-generator")
 
-    val protoFile by parser.option(ArgType.String, shortName = "p", description = "Path to the proto file").required()
+    val protoFiles by parser.option(
+        ArgType.String,
+        shortName = "p",
+        fullName = "protoFile",
+        description = "Path to a proto file; repeat for a batch"
+    ).multiple()
+    val protoDir by parser.option(
+        ArgType.String,
+        shortName = "d",
+        description = "Generate bindings for every proto file under this directory"
+    )
     val outputDir by parser.option(ArgType.String, shortName = "o", description = "Output directory").required()
     val includeDir by parser.option(ArgType.String, shortName = "I", description = "Include directory for imports")
+    val benchmark by parser.option(
+        ArgType.Boolean,
+        shortName = "b",
+        description = "Also generate a Google Benchmark suite and a CMake snippet that builds it"
+    ).default(false)
+    val jni by parser.option(
+        ArgType.Boolean,
+        shortName = "j",
+        description = "Also generate JNI glue and Kotlin bindings for the services in the proto file"
+    ).default(false)
+    val jmh by parser.option(
+        ArgType.Boolean,
+        description = "Also generate a JMH benchmark of the Kotlin mappers and a Gradle script that runs it"
+    ).default(false)
+
+    // Corpus mode: write serialized synthetic messages instead of bindings
+    val corpusMessage by parser.option(
+        ArgType.String,
+        shortName = "m",
+        description = "Write a corpus of this message (simple or full name) instead of generating bindings"
+    )
+    val corpusCount by parser.option(ArgType.Int, description = "Messages in the corpus").default(1000)
+    val repeatedCount by parser.option(ArgType.Int, description = "Elements per repeated field").default(16)
+    val repeatedLength by parser.option(
+        ArgType.String,
+        description = "Per-field repeated length as field=count, e.g. arcs=500"
+    ).multiple()
+    val stringLength by parser.option(ArgType.Int, description = "Characters per string value").default(32)
+    val bytesLength by parser.option(ArgType.Int, description = "Bytes per bytes value").default(1024)
+    val optionalPresence by parser.option(
+        ArgType.Double,
+        description = "Probability that an optional field is set"
+    ).default(1.0)
+    val oneofMember by parser.option(ArgType.Int, description = "Oneof member index to set (random if omitted)")
+    val oneofWeight by parser.option(
+        ArgType.String,
+        description = "Relative weight of a oneof member as field=weight, e.g. stop=3 (others weigh 1)"
+    ).multiple()
+    val seed by parser.option(ArgType.Int, description = "Random seed").default(42)
 
     parser.parse(args)
 
-    val proto = File(protoFile)
     val output = File(outputDir)
-    val includes = if (includeDir != null) listOf(File(includeDir!!)) else emptyList()
+    val includes = listOfNotNull(includeDir, protoDir).map { File(it) }
+    val protos = protoFiles.map { File(it) } + (protoDir?.let { dir ->
+        File(dir).walkTopDown().filter { it.isFile && it.extension == "proto" }.sorted().toList()
+    } ?: emptyList())
+    require(protos.isNotEmpty()) { "Pass a proto file with -p or a directory with -d" }
 
     output.mkdirs()
 
     val protoParser = ProtoParser()
-    val parsedFile = protoParser.parseProtoFile(proto, includes)
+
+    corpusMessage?.let { messageName ->
+        require(protos.size == 1) { "Corpus mode takes a single proto file" }
+        val proto = protos.single()
+        val fileDescriptor = protoParser.loadFileDescriptor(proto, includes)
+        val descriptor = findMessage(fileDescriptor.messageTypes, messageName)
+            ?: error("Message $messageName not found in ${proto.name}")
+        val corpusConfig = CorpusConfig(
+            repeatedCount = repeatedCount,
+            repeatedCounts = repeatedLength.associate { spec ->
+                val parts = spec.split('=', limit = 2)
+                require(parts.size == 2) { "--repeatedLength expects field=count, got $spec" }
+                parts[0] to parts[1].toInt()
+            },
+            stringLength = stringLength,
+            bytesLength = bytesLength,
+            optionalPresence = optionalPresence,
+            oneofMember = oneofMember,
+            oneofWeights = oneofWeight.associate { spec ->
+                val parts = spec.split('=', limit = 2)
+                val weight = parts.getOrNull(1)?.toDoubleOrNull()
+                require(weight != null && weight >= 0.0) { "--oneofWeight expects field=weight >= 0, got $spec" }
+                parts[0] to weight
+            },
+            seed = seed
+        )
+        val corpusFile = File(output, "${descriptor.name}.corpus.bin")
+        CorpusGenerator(corpusConfig).writeCorpus(descriptor, corpusCount, corpusFile)
+        println("Wrote $corpusCount ${descriptor.fullName} messages to ${corpusFile.absolutePath}")
+        return
+    }
+
+    val options = GenerationOptions(benchmark = benchmark, jni = jni, jmh = jmh)
+
+    // A single proto file keeps the flat layout
+    if (protos.size == 1 && protoDir == null) {
+        val proto = protos.single()
+        val descriptorSet = protoParser.compileDescriptorSet(proto, includes)
+        println(generateBindings(protoParser, descriptorSet, protoParser.protoName(proto, includes), output, options))
+        return
+    }
+
+    // Batch: one protoc run for every file, then one output subdirectory per file, generated in parallel
+    // Two inputs with the same include-relative name would share one descriptor and one output directory
+    val protosByName = protos.groupBy { protoParser.protoName(it, includes) }
+        .mapValues { (name, files) ->
+            val paths = files.map { it.absoluteFile }.distinct()
+            require(paths.size == 1) { "${paths.joinToString(" and ")} all resolve to $name" }
+            paths.single()
+        }
+    val descriptorSet = protoParser.compileDescriptorSet(protosByName.values.toList(), includes)
+    val protoNames = protosByName.keys.toList()
+    val outputDirs = protoNames.associateWith { File(output, it.removeSuffix(".proto")) }
+    val executor = Executors.newFixedThreadPool(Runtime.getRuntime().availableProcessors())
+    try {
+        val results = protoNames.map { name ->
+            executor.submit<String> {
+                val fileOutput = outputDirs.getValue(name)
+                generateBindings(protoParser, descriptorSet, name, fileOutput, options)
+            }
+        }
+        results.forEach { println(it.get()) }
+    } finally {
+        executor.shutdown()
+    }
+}
+
+/** CLI switches that add outputs on top of the C++ helpers and the Kotlin mapper. */
+private data class GenerationOptions(val benchmark: Boolean, val jni: Boolean, val jmh: Boolean)
+
+/**
+ * Generates the bindings of [protoName] from [descriptorSet] into [output], unless its manifest shows
+ * they are up to date. Returns the line to report.
+ */
+private fun generateBindings(
+    protoParser: ProtoParser,
+    descriptorSet: DescriptorProtos.FileDescriptorSet,
+    protoName: String,
+    output: File,
+    options: GenerationOptions
+): String {
+    // Everything the outputs depend on, so an unchanged hash means unchanged outputs
+    val inputHash = sha256(
+        GENERATOR_VERSION.toByteArray(),
+        *descriptorClosure(descriptorSet, protoName).map { it.toByteArray() }.toTypedArray(),
+        GeneratorConfig.DEFAULT.toString().toByteArray(),
+        KotlinGeneratorConfig.DEFAULT.toString().toByteArray(),
+        "year=$copyrightYear $options".toByteArray()
+    )
+    if (GenerationManifest.read(output)?.isUpToDate(output, inputHash) == true) {
+        return "Bindings for $protoName in ${output.absolutePath} are up to date"
+    }
+
+    val parsedFile = protoParser.parseDescriptorSet(descriptorSet, protoName)
+    val messages = mutableListOf<String>()
+    val written = mutableListOf<File>()
 
     val cppGenerator = CppGenerator()
-    val baseName = proto.nameWithoutExtension
-    cppGenerator.generateHeader(parsedFile, File(output, "protobuf_helpers.hpp"))
-    cppGenerator.generateImplementation(parsedFile, File(output, "protobuf_helpers.hpp"), File(output, "protobuf_helpers.cpp"))
+    val baseName = File(protoName).nameWithoutExtension
+    output.mkdirs()
+    written += cppGenerator.generateHeader(parsedFile, File(output, "protobuf_helpers.hpp"))
+    written += cppGenerator.generateImplementation(
+        parsedFile,
+        File(output, "protobuf_helpers.hpp"),
+        File(output, "protobuf_helpers.cpp")
+    )
+
+    if (options.benchmark) {
+        val benchmarkGenerator = CppBenchmarkGenerator()
+        val benchmarkFile = File(output, "${baseName}_benchmark.cpp")
+        written += benchmarkGenerator.generateBenchmark(parsedFile, File(output, "protobuf_helpers.hpp"), benchmarkFile)
+        written += benchmarkGenerator.generateCMake(benchmarkFile, File(output, "protobuf_helpers.cpp"), File(output, "${baseName}_benchmark.cmake"))
+    }
 
     val kotlinGenerator = KotlinGenerator()
-    kotlinGenerator.generateMapper(parsedFile, output)
+    written += kotlinGenerator.generateMapper(parsedFile, output)
+
+    if (options.jmh) {
+        val jmhGenerator = KotlinBenchmarkGenerator()
+        val jmhDir = File(output, "jmh")
+        val className = baseName.split('_', '-', '.').joinToString("") { part -> part.replaceFirstChar { it.uppercase() } }
+        written += jmhGenerator.generateBenchmark(parsedFile, "${className}MapperBenchmark", jmhDir)
+        written += jmhGenerator.generateGradle(jmhDir, File(output, "${baseName}_jmh.gradle.kts"))
+    }
+
+    if (options.jni) {
+        if (parsedFile.services.isEmpty()) {
+            messages.add("No services in $protoName, skipping JNI bindings")
+        } else {
+            written += JniGenerator().generateGlue(parsedFile, File(output, "${baseName}_jni.cpp"))
+            written += kotlinGenerator.generateNativeBindings(parsedFile, output)
+            written += kotlinGenerator.generateNativeClient(parsedFile, output)
+        }
+    }
+
+    GenerationManifest.of(output, inputHash, written).write(output)
+    messages.add("Generated bindings for $protoName in ${output.absolutePath}")
+    return messages.joinToString("\n")
+}
 
-    println("Generated bindings for ${proto.name} in ${output.absolutePath}")
+/** [protoName] and the files it imports, directly or not, in descriptor set order. */
+private fun descriptorClosure(
+    descriptorSet: DescriptorProtos.FileDescriptorSet,
+    protoName: String
+): List<DescriptorProtos.FileDescriptorProto> {
+    val byName = descriptorSet.fileList.associateBy { it.name }
+    val needed = mutableSetOf<String>()
+    fun visit(name: String) {
+        if (needed.add(name)) byName[name]?.dependencyList?.forEach { visit(it) }
+    }
+    require(protoName in byName) {
+        "$protoName is not in the descriptor set, which has: ${byName.keys.joinToString()}"
+    }
+    visit(protoName)
+    return descriptorSet.fileList.filter { it.name in needed }
 }
 
+private fun findMessage(messages: List<Descriptors.Descriptor>, name: String): Descriptors.Descriptor? =
+    messages.firstNotNullOfOrNull { message ->
+        if (message.name == name || message.fullName == name) message else findMessage(message.nestedTypes, name)
+    }
@@ -0,0 +1,125 @@
+package com.tomtom.sdk.tools.bindingsgenerator
+
+import com.squareup.kotlinpoet.FileSpec
+import java.io.File
+import java.security.MessageDigest
+import java.time.Instant
+import java.time.Year
+import java.time.ZoneOffset
+
+/**
+ * Identifies the code of this generator: its version from the jar manifest, or `dev` when running from
+ * the build tree, plus a digest of the jar or class directory it was loaded from. A rebuilt generator
+ * therefore invalidates earlier outputs even when the version string stays the same.
+ */
+val GENERATOR_VERSION: String by lazy {
+    val version = ProtoParser::class.java.`package`?.implementationVersion ?: "dev"
+    "$version+${generatorCodeDigest()}"
+}
+
+private fun generatorCodeDigest(): String {
+    val location = ProtoParser::class.java.protectionDomain?.codeSource?.location
+        ?: return "unknown"
+    val root = File(location.toURI())
+    val files = if (root.isDirectory) {
+        root.walkTopDown().filter { it.isFile }.sortedBy { it.relativeTo(root).invariantSeparatorsPath }.toList()
+    } else {
+        listOf(root)
+    }
+    return sha256(
+        *files.flatMap { listOf(it.relativeTo(root).invariantSeparatorsPath.toByteArray(), it.readBytes()) }
+            .toTypedArray()
+    )
+}
+
+/**
+ * Year stamped into the copyright headers. Taken from `SOURCE_DATE_EPOCH` when it is set, as in other
+ * reproducible builds, so the output only depends on the inputs.
+ */
+val copyrightYear: Int = System.getenv("SOURCE_DATE_EPOCH")?.toLongOrNull()
+    ?.let { Instant.ofEpochSecond(it).atZone(ZoneOffset.UTC).year }
+    ?: Year.now().value
+
+/**
+ * Writes [content] to [file] unless the file already holds exactly these bytes, so the mtime of an
+ * unchanged output never moves and build systems do not recompile its dependents.
+ *
+ * @return true if the file was written
+ */
+fun writeIfChanged(file: File, content: String): Boolean {
+    val bytes = content.toByteArray()
+    if (file.isFile && file.length() == bytes.size.toLong() && file.readBytes().contentEquals(bytes)) {
+        return false
+    }
+    file.parentFile?.mkdirs()
+    file.writeBytes(bytes)
+    return true
+}
+
+/** Like [FileSpec.writeTo], but through [writeIfChanged]. Returns the path of the file. */
+fun FileSpec.writeToIfChanged(outputDir: File, content: String = toString()): File {
+    val file = File(outputDir, "${packageName.replace('.', '/')}/$name.kt".removePrefix("/"))
+    writeIfChanged(file, content)
+    return file
+}
+
+fun sha256(vararg parts: ByteArray): String {
+    val digest = MessageDigest.getInstance("SHA-256")
+    parts.forEach { part ->
+        // Length prefix, so moving bytes between parts changes the hash
+        digest.update(part.size.toString().toByteArray())
+        digest.update(0)
+        digest.update(part)
+    }
+    return digest.digest().joinToString("") { "%02x".format(it) }
+}
+
+/**
+ * Records what produced an output directory: a hash of every input (descriptor set, generator
+ * config and version) and a hash of every file written. When the input hash matches and no output
+ * was modified or deleted, a run can stop before generating anything.
+ *
+ * Stored as [FILE_NAME] in the output directory, one `path hash` pair per line after the input hash.
+ */
+data class GenerationManifest(val inputHash: String, val outputs: Map<String, String>) {
+
+    fun isUpToDate(outputDir: File, inputHash: String): Boolean =
+        inputHash == this.inputHash && outputs.all { (path, hash) ->
+            val file = File(outputDir, path)
+            file.isFile && sha256(file.readBytes()) == hash
+        }
+
+    fun write(outputDir: File) {
+        val content = buildString {
+            appendLine(inputHash)
+            outputs.toSortedMap().forEach { (path, hash) -> appendLine("$path $hash") }
+        }
+        writeIfChanged(File(outputDir, FILE_NAME), content)
+    }
+
+    companion object {
+        const val FILE_NAME = ".bindings-generator.manifest"
+
+        fun read(outputDir: File): GenerationManifest? {
+            val file = File(outputDir, FILE_NAME)
+            if (!file.isFile) return null
+            val lines = file.readLines().filter { it.isNotBlank() }
+            if (lines.isEmpty()) return null
+            val outputs = lines.drop(1).associate { line ->
+                line.substringBeforeLast(' ') to line.substringAfterLast(' ')
+            }
+            return GenerationManifest(lines.first(), outputs)
+        }
+
+        /**
+         * Hashes the [written] files of a run, with paths relative to [outputDir]. Anything else in the
+         * directory, such as the outputs of other proto files or the user's own files, is left out.
+         */
+        fun of(outputDir: File, inputHash: String, written: Collection<File>): GenerationManifest {
+            val outputs = written.associate { file ->
+                file.absoluteFile.relativeTo(outputDir.absoluteFile).invariantSeparatorsPath to sha256(file.readBytes())
+            }
+            return GenerationManifest(inputHash, outputs)
+        }
+    }
+}
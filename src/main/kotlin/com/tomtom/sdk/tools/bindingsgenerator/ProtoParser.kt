@@ -1,13 +1,15 @@
 package com.tomtom.sdk.tools.bindingsgenerator
 
 import com.google.protobuf.DescriptorProtos
+import com.google.protobuf.Descriptors
 import java.io.File
 
 data class ParsedProtoFile(
     val packageName: String,
     val protoPackage: String,
     val messages: List<ParsedMessage>,
-    val enums: List<ParsedEnum>
+    val enums: List<ParsedEnum>,
+    val services: List<ParsedService> = emptyList()
 )
 
 data class ParsedMessage(
@@ -33,7 +35,9 @@ data class ParsedField(
     val isOptional: Boolean = false,
     val isEnum: Boolean = false,
     val isMessage: Boolean = false,
-    val typeName: String = ""
+    val typeName: String = "",
+    /** Exact proto type keyword (e.g. "sint32", "fixed64", "enum"); [type] collapses these for native mapping. */
+    val protoType: String = ""
 )
 
 data class ParsedEnum(
@@ -47,26 +51,100 @@ data class ParsedEnumValue(
     val number: Int
 )
 
+data class ParsedService(
+    val name: String,
+    val fullName: String,
+    val methods: List<ParsedMethod>
+)
+
+/** A unary rpc. [inputType] and [outputType] are fully qualified with a leading dot, as in [ParsedField.typeName]. */
+data class ParsedMethod(
+    val name: String,
+    val inputType: String,
+    val outputType: String
+)
+
 class ProtoParser {
 
-    fun parseProtoFile(protoFile: File, includeDirs: List<File>): ParsedProtoFile {
+    fun parseProtoFile(protoFile: File, includeDirs: List<File>): ParsedProtoFile =
+        parseDescriptorSet(compileDescriptorSet(protoFile, includeDirs), protoName(protoFile, includeDirs))
+
+    /**
+     * Parses [fileName] from a descriptor set returned by [compileDescriptorSet].
+     *
+     * @throws IllegalArgumentException if the set has no file named [fileName]
+     */
+    fun parseDescriptorSet(fileDescriptorSet: DescriptorProtos.FileDescriptorSet, fileName: String): ParsedProtoFile =
+        parseFileDescriptor(findFile(fileDescriptorSet, fileName))
+
+    /**
+     * Builds the runtime [Descriptors.FileDescriptor] of [protoFile], with its imports linked, for
+     * tools that need to create messages dynamically.
+     */
+    fun loadFileDescriptor(protoFile: File, includeDirs: List<File>): Descriptors.FileDescriptor {
+        val fileDescriptorSet = compileDescriptorSet(protoFile, includeDirs)
+
+        // --include_imports lists every dependency before the files that import it
+        val built = mutableMapOf<String, Descriptors.FileDescriptor>()
+        fileDescriptorSet.fileList.forEach { fileProto ->
+            val dependencies = fileProto.dependencyList.map { built.getValue(it) }.toTypedArray()
+            built[fileProto.name] = Descriptors.FileDescriptor.buildFrom(fileProto, dependencies)
+        }
+        return built.getValue(findFile(fileDescriptorSet, protoName(protoFile, includeDirs)).name)
+    }
+
+    /**
+     * Runs protoc on [protoFile] and returns the descriptors of the file and everything it imports. The
+     * file is named as [protoName] reports.
+     */
+    fun compileDescriptorSet(protoFile: File, includeDirs: List<File>): DescriptorProtos.FileDescriptorSet =
+        runProtoc(listOf(protoName(protoFile, includeDirs)), includeDirs + protoFile.parentFile)
+
+    /**
+     * Runs protoc once for all [protoFiles] and returns the descriptors of every file and everything
+     * they import. Each file is named as [protoName] reports, which is the name to look it up with in
+     * [parseDescriptorSet].
+     */
+    fun compileDescriptorSet(protoFiles: List<File>, includeDirs: List<File>): DescriptorProtos.FileDescriptorSet {
+        val protoPaths = (includeDirs.map { it.absoluteFile } + protoFiles.map { protoRoot(it, includeDirs) }).distinct()
+        return runProtoc(protoFiles.map { protoName(it, includeDirs) }, protoPaths)
+    }
+
+    /** Name of [protoFile] relative to the first of [includeDirs] that contains it, or to its own directory. */
+    fun protoName(protoFile: File, includeDirs: List<File>): String =
+        protoFile.absoluteFile.relativeTo(protoRoot(protoFile, includeDirs)).invariantSeparatorsPath
+
+    /**
+     * Looks [fileName] up in [fileDescriptorSet] instead of guessing, since the last file of the set is
+     * not necessarily the one that was asked for.
+     */
+    private fun findFile(
+        fileDescriptorSet: DescriptorProtos.FileDescriptorSet,
+        fileName: String
+    ): DescriptorProtos.FileDescriptorProto =
+        requireNotNull(fileDescriptorSet.fileList.find { it.name == fileName }) {
+            "$fileName is not in the descriptor set, which has: ${fileDescriptorSet.fileList.joinToString { it.name }}"
+        }
+
+    private fun protoRoot(protoFile: File, includeDirs: List<File>): File =
+        includeDirs.map { it.absoluteFile }.firstOrNull { protoFile.absoluteFile.startsWith(it) }
+            ?: protoFile.absoluteFile.parentFile
+
+    private fun runProtoc(protoNames: List<String>, protoPaths: List<File>): DescriptorProtos.FileDescriptorSet {
         val tempDescriptor = File.createTempFile("proto_descriptor", ".bin")
         tempDescriptor.deleteOnExit()
 
         try {
-            val protocPath = findProtoc()
             val args = mutableListOf(
                 protocPath,
                 "--descriptor_set_out=${tempDescriptor.absolutePath}",
                 "--include_imports",
                 "--include_source_info"
             )
-            includeDirs.forEach { args.add("--proto_path=${it.absolutePath}") }
-            args.add("--proto_path=${protoFile.parentFile.absolutePath}")
-            args.add(protoFile.name)
+            protoPaths.forEach { args.add("--proto_path=${it.absolutePath}") }
+            args.addAll(protoNames)
 
             val process = ProcessBuilder(args)
-                .directory(protoFile.parentFile)
                 .redirectErrorStream(true)
                 .start()
 
@@ -77,33 +155,14 @@ class ProtoParser {
                 throw RuntimeException("protoc failed with exit code $exitCode:\n$output")
             }
 
-            val fileDescriptorSet = tempDescriptor.inputStream().use { input ->
+            return tempDescriptor.inputStream().use { input ->
                 DescriptorProtos.FileDescriptorSet.parseFrom(input)
             }
-
-            val targetFileName = protoFile.name
-            val targetFileDescriptor = fileDescriptorSet.fileList.find { it.name == targetFileName }
-                ?: fileDescriptorSet.fileList.last()
-
-            return parseFileDescriptor(targetFileDescriptor)
         } finally {
             tempDescriptor.delete()
         }
     }
 
-    private fun findProtoc(): String {
-        val candidates = listOf("protoc", "/usr/local/bin/protoc", "/usr/bin/protoc", "/opt/homebrew/bin/protoc")
-        for (candidate in candidates) {
-            try {
-                val process = ProcessBuilder(candidate, "--version").start()
-                if (process.waitFor() == 0) return candidate
-            } catch (e: Exception) {
-                // try next
-            }
-        }
-        return "protoc"
-    }
-
     private fun parseFileDescriptor(fileDescriptor: DescriptorProtos.FileDescriptorProto): ParsedProtoFile {
         val packageName = fileDescriptor.`package`.replace('.', '/')
             .split("/").joinToString(".") { it }
@@ -120,12 +179,16 @@ class ProtoParser {
         val enums = fileDescriptor.enumTypeList.map { enumDescriptor ->
             parseEnum(enumDescriptor, protoPackage)
         }
+        val services = fileDescriptor.serviceList.map { serviceDescriptor ->
+            parseService(serviceDescriptor, protoPackage)
+        }
 
         return ParsedProtoFile(
             packageName = protoPackage,
             protoPackage = protoPackage,
             messages = messages,
-            enums = enums
+            enums = enums,
+            services = services
         )
     }
 
@@ -244,7 +307,23 @@ class ProtoParser {
             isOptional = isOptional,
             isEnum = typeInfo.isEnum,
             isMessage = typeInfo.isMessage,
-            typeName = descriptor.typeName
+            typeName = descriptor.typeName,
+            protoType = descriptor.type.name.removePrefix("TYPE_").lowercase()
+        )
+    }
+
+    private fun parseService(
+        descriptor: DescriptorProtos.ServiceDescriptorProto,
+        packageName: String
+    ): ParsedService {
+        // Only unary rpcs map onto a single native call
+        val methods = descriptor.methodList
+            .filter { !it.clientStreaming && !it.serverStreaming }
+            .map { ParsedMethod(name = it.name, inputType = it.inputType, outputType = it.outputType) }
+        return ParsedService(
+            name = descriptor.name,
+            fullName = "$packageName.${descriptor.name}",
+            methods = methods
         )
     }
 
@@ -261,5 +340,23 @@ class ProtoParser {
             values = values
         )
     }
+
+    companion object {
+        /** Probed once per process, since every probe spawns a process. */
+        private val protocPath: String by lazy { findProtoc() }
+
+        private fun findProtoc(): String {
+            val candidates = listOf("protoc", "/usr/local/bin/protoc", "/usr/bin/protoc", "/opt/homebrew/bin/protoc")
+            for (candidate in candidates) {
+                try {
+                    val process = ProcessBuilder(candidate, "--version").start()
+                    if (process.waitFor() == 0) return candidate
+                } catch (e: Exception) {
+                    // try next
+                }
+            }
+            return "protoc"
+        }
+    }
 }
 
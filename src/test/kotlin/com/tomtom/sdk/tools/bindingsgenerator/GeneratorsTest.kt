@@ -1,5 +1,9 @@
 package com.tomtom.sdk.tools.bindingsgenerator
 
+import com.google.protobuf.ByteString
+import com.google.protobuf.DescriptorProtos
+import com.google.protobuf.Descriptors
+import com.google.protobuf.DynamicMessage
 import org.junit.jupiter.api.Test
 import org.junit.jupiter.api.io.TempDir
 import java.io.File
@@ -177,6 +181,187 @@ class CppGeneratorTest {
         val content = headerFile.readText()
         assertTrue(content.contains("Inner"))
     }
+
+    @Test
+    fun `test ToNative takes proto by reference and has in-place overload`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage(
+                    name = "Route",
+                    fullName = "com.test.Route",
+                    fields = listOf(
+                        ParsedField("id", "id", "string", 1),
+                        ParsedField("arcs", "arcs", "Arc", 2, isRepeated = true, isMessage = true)
+                    )
+                )
+            ),
+            enums = emptyList()
+        )
+
+        val generator = CppGenerator()
+        val headerFile = File(tempDir, "route.hpp")
+        val implFile = File(tempDir, "route.cpp")
+        generator.generateHeader(parsedFile, headerFile)
+        generator.generateImplementation(parsedFile, headerFile, implFile)
+
+        val header = headerFile.readText()
+        assertTrue(header.contains("Route ToNative(const Route& proto);"))
+        assertTrue(header.contains("void ToNative(const Route& proto, Route* out);"))
+        assertFalse(header.contains("ToNative(const Route proto)"), "Messages must not be taken by value")
+
+        val impl = implFile.readText()
+        assertTrue(impl.contains("ToNative(proto, &result);"), "By-value form should delegate to the in-place one")
+        assertTrue(impl.contains("out->arcs.resize(proto.arcs_size());"), "Repeated messages should reuse existing elements")
+        assertTrue(impl.contains("ToNative(proto.arcs(i), &out->arcs[i]);"))
+    }
+
+    @Test
+    fun `test in-place ToNative resets the oneof so a reused out keeps no stale case`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage(
+                    name = "Result",
+                    fullName = "com.test.Result",
+                    fields = emptyList(),
+                    oneofs = listOf(ParsedOneof("Value", listOf(
+                        ParsedField("routes", "routes", "RouteList", 1, isMessage = true),
+                        ParsedField("message", "message", "string", 2)
+                    )))
+                )
+            ),
+            enums = emptyList()
+        )
+
+        val generator = CppGenerator()
+        val headerFile = File(tempDir, "result.hpp")
+        val implFile = File(tempDir, "result.cpp")
+        generator.generateHeader(parsedFile, headerFile)
+        generator.generateImplementation(parsedFile, headerFile, implFile)
+        val impl = implFile.readText()
+
+        // ToNative(routesProto, &out) then ToNative(messageProto, &out): the second call must clear routes
+        // and move the discriminator, and a proto with no case set must leave out with no case either
+        val inPlace = impl.substringAfter("void ToNative(const Result& proto, Result* out) {").substringBefore("\n}")
+        val reset = "    out->Value_case = {};\n    out->routes = {};\n    out->message = {};\n    switch (proto.Value_case()) {"
+        assertTrue(inPlace.contains(reset), "Every member and the discriminator should be reset before the switch")
+        assertTrue(inPlace.contains(
+            "case Result::kRoutes: ToNative(proto.routes(), &out->routes); out->Value_case = Result::kRoutes; break;"
+        ), "Message members should convert through ToNative and set the case")
+        assertTrue(inPlace.contains(
+            "case Result::kMessage: out->message = proto.message(); out->Value_case = Result::kMessage; break;"
+        ))
+        assertTrue(inPlace.contains("        default: break;"))
+    }
+
+    @Test
+    fun `test rvalue ToNative moves buffers out of the proto`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage(
+                    name = "Image",
+                    fullName = "com.test.Image",
+                    fields = listOf(
+                        ParsedField("dataPng", "data_png", "bytes", 1),
+                        ParsedField("width", "width", "int32", 2),
+                        ParsedField("tags", "tags", "string", 3, isRepeated = true)
+                    )
+                )
+            ),
+            enums = emptyList()
+        )
+
+        val generator = CppGenerator()
+        val headerFile = File(tempDir, "image.hpp")
+        val implFile = File(tempDir, "image.cpp")
+        generator.generateHeader(parsedFile, headerFile)
+        generator.generateImplementation(parsedFile, headerFile, implFile)
+
+        val header = headerFile.readText()
+        assertTrue(header.contains("Image ToNative(Image&& proto);"))
+        assertTrue(header.contains("void ToNative(Image&& proto, Image* out);"))
+        assertTrue(header.contains("#include <utility>"))
+
+        val impl = implFile.readText()
+        assertTrue(impl.contains("ToNative(std::move(proto), &result);"))
+        assertTrue(impl.contains("out->dataPng = std::move(*proto.mutable_data_png());"), "bytes should be moved")
+        assertTrue(impl.contains("out->tags.push_back(std::move(item));"), "repeated strings should be moved")
+        assertFalse(impl.contains("std::move(*proto.mutable_width())"), "scalars should be copied")
+    }
+
+    @Test
+    fun `test rvalue ToNative converts moved oneof messages and moves only buffers raw`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage(
+                    name = "Result",
+                    fullName = "com.test.Result",
+                    fields = emptyList(),
+                    oneofs = listOf(ParsedOneof("Value", listOf(
+                        ParsedField("routes", "routes", "RouteList", 1, isMessage = true),
+                        ParsedField("payload", "payload", "bytes", 2)
+                    )))
+                )
+            ),
+            enums = emptyList()
+        )
+
+        val generator = CppGenerator()
+        val headerFile = File(tempDir, "result.hpp")
+        val implFile = File(tempDir, "result.cpp")
+        generator.generateHeader(parsedFile, headerFile)
+        generator.generateImplementation(parsedFile, headerFile, implFile)
+        val moved = implFile.readText().substringAfter("void ToNative(Result&& proto, Result* out) {").substringBefore("\n}")
+
+        assertTrue(moved.contains("    out->Value_case = {};"), "The move overload should reset the oneof too")
+        assertTrue(moved.contains(
+            "case Result::kRoutes: ToNative(std::move(*proto.mutable_routes()), &out->routes); out->Value_case = Result::kRoutes;"
+        ), "Message members should be converted, not assigned as proto objects")
+        assertTrue(moved.contains(
+            "case Result::kPayload: out->payload = std::move(*proto.mutable_payload()); out->Value_case = Result::kPayload;"
+        ))
+        assertFalse(moved.contains("out->routes = std::move("))
+    }
+
+    @Test
+    fun `test in-place ToProto fills nested messages without temporaries`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage(
+                    name = "Announcement",
+                    fullName = "com.test.Announcement",
+                    fields = listOf(
+                        ParsedField("instruction", "instruction", "Instruction", 1, isMessage = true),
+                        ParsedField("lanes", "lanes", "Lane", 2, isRepeated = true, isMessage = true)
+                    )
+                )
+            ),
+            enums = emptyList()
+        )
+
+        val generator = CppGenerator()
+        val headerFile = File(tempDir, "announcement.hpp")
+        val implFile = File(tempDir, "announcement.cpp")
+        generator.generateHeader(parsedFile, headerFile)
+        generator.generateImplementation(parsedFile, headerFile, implFile)
+
+        assertTrue(headerFile.readText().contains("void ToProto(const Announcement& native, Announcement* out);"))
+
+        val impl = implFile.readText()
+        assertTrue(impl.contains("ToProto(native, &result);"), "By-value form should delegate to the in-place one")
+        assertTrue(impl.contains("ToProto(native.instruction, out->mutable_instruction());"))
+        assertTrue(impl.contains("ToProto(item, out->add_lanes());"))
+        assertFalse(impl.contains("CopyFrom"), "Nested messages must not be copied from temporaries")
+    }
 }
 
 /**
@@ -414,6 +599,137 @@ class KotlinGeneratorTest {
             "Must not silently fall back to a default enum value"
         )
     }
+
+    @Test
+    fun `allocation-free config emits plain builders and indexed loops`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage(
+                    name = "RouteWindow",
+                    fullName = "com.test.RouteWindow",
+                    fields = listOf(
+                        ParsedField("offsets", "offsets", "int32", 1, isRepeated = true),
+                        ParsedField("arcs", "arcs", "RouteArc", 2, isRepeated = true, isMessage = true, typeName = ".com.test.RouteArc"),
+                        ParsedField("label", "label", "string", 3, isOptional = true)
+                    )
+                )
+            ),
+            enums = emptyList()
+        )
+
+        KotlinGenerator(KotlinGeneratorConfig(allocationFreeMappers = true)).generateMapper(parsedFile, tempDir)
+        val content = tempDir.walkTopDown().single { it.name == "NativeModelMapper.kt" }.readText()
+
+        assertTrue(content.contains("val builder = RouteWindow.newBuilder()"))
+        assertTrue(content.contains("builder.addAllOffsets(this.offsets)"), "Repeated scalars should not be copied first")
+        assertTrue(content.contains("for (i in this.arcs.indices) builder.addArcs(this.arcs[i].toProto())"))
+        assertTrue(content.contains("this.label?.let { builder.setLabel(it) }"))
+        assertTrue(content.contains("val arcsNative = ArrayList<RouteArc>(arcsProto.size)"))
+        assertTrue(content.contains("offsets = this.offsetsList,"))
+        assertTrue(content.contains("label = if (this.hasLabel()) this.label else null,"))
+        assertFalse(content.contains(".map {"), "No intermediate lists should be built")
+        assertFalse(content.contains("routeWindow {"), "No DSL builders should be used")
+    }
+
+    @Test
+    fun `enum lookup tables config converts through arrays and keeps throwing`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = emptyList(),
+            enums = listOf(
+                ParsedEnum("Side", "com.test.Side", listOf(ParsedEnumValue("kSideLeft", 0), ParsedEnumValue("kSideRight", 1))),
+                ParsedEnum("Code", "com.test.Code", listOf(ParsedEnumValue("kCodeOk", 0), ParsedEnumValue("kCodeGone", 410)))
+            )
+        )
+
+        KotlinGenerator(KotlinGeneratorConfig(enumLookupTables = true)).generateMapper(parsedFile, tempDir)
+        val content = tempDir.walkTopDown().single { it.name == "NativeModelMapper.kt" }.readText()
+
+        assertTrue(content.contains("private object SideTables"))
+        assertTrue(content.contains("this[Side.RIGHT.ordinal] = Side.kSideRight"))
+        assertTrue(content.contains("this[1] = Side.RIGHT"))
+        assertTrue(content.contains("SideTables.protoByNativeOrdinal[ordinal] ?: throw"))
+        assertTrue(content.contains("SideTables.nativeByProtoNumber.getOrNull(number) ?: throw"))
+        assertFalse(content.contains("CodeTables.nativeByProtoNumber"), "Sparse numbers should keep the when")
+        assertTrue(content.contains("Code.kCodeGone -> Code.GONE"))
+    }
+
+    @Test
+    fun `lazy repeated messages config maps message lists through LazyMappedList`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage(
+                    name = "JunctionViewInformationList",
+                    fullName = "com.test.JunctionViewInformationList",
+                    fields = listOf(
+                        ParsedField("junctionViews", "junction_views", "JunctionViewInformation", 1, isRepeated = true,
+                            isMessage = true, typeName = ".com.test.JunctionViewInformation"),
+                        ParsedField("ids", "ids", "int64", 2, isRepeated = true)
+                    )
+                )
+            ),
+            enums = emptyList()
+        )
+
+        KotlinGenerator(KotlinGeneratorConfig(lazyRepeatedMessages = true, cacheLazyElements = false))
+            .generateMapper(parsedFile, tempDir)
+        val content = tempDir.walkTopDown().single { it.name == "NativeModelMapper.kt" }.readText()
+
+        assertTrue(content.contains("internal class LazyMappedList<S, T>("))
+        assertTrue(content.contains(") : AbstractList<T>(), RandomAccess {"))
+        assertTrue(content.contains("junctionViews = LazyMappedList(this@toNative.junctionViewsList, false) { it.toNative() }"))
+        assertTrue(content.contains("ids = this@toNative.idsList"), "Scalar lists should stay as they are")
+
+        File(tempDir, "allocation-free").let { dir ->
+            KotlinGenerator(KotlinGeneratorConfig(allocationFreeMappers = true, lazyRepeatedMessages = true))
+                .generateMapper(parsedFile, dir)
+            val allocationFree = dir.walkTopDown().single { it.name == "NativeModelMapper.kt" }.readText()
+            assertTrue(allocationFree.contains("junctionViews = LazyMappedList(this.junctionViewsList, true) { it.toNative() },"))
+            assertFalse(allocationFree.contains("junctionViewsNative"), "Lazy fields should not be converted up front")
+        }
+    }
+
+    @Test
+    fun `bytes mapping config maps bytes fields without copies unless asked to`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage(
+                    name = "JunctionViewInformation",
+                    fullName = "com.test.JunctionViewInformation",
+                    fields = listOf(
+                        ParsedField("dataPng", "data_png", "bytes", 1),
+                        ParsedField("thumbnail", "thumbnail", "bytes", 2, isOptional = true)
+                    )
+                )
+            ),
+            enums = emptyList()
+        )
+
+        val config = KotlinGeneratorConfig(
+            bytesMapping = BytesMapping.READ_ONLY_BYTE_BUFFER,
+            bytesFieldMappings = mapOf("JunctionViewInformation.thumbnail" to BytesMapping.BYTE_ARRAY)
+        )
+        KotlinGenerator(config).generateMapper(parsedFile, tempDir)
+        val content = tempDir.walkTopDown().single { it.name == "NativeModelMapper.kt" }.readText()
+
+        assertTrue(content.contains("dataPng = this@toNative.data_png.asReadOnlyByteBuffer()"))
+        assertTrue(content.contains("data_png = UnsafeByteOperations.unsafeWrap(this@toProto.dataPng)"))
+        assertTrue(content.contains("thumbnail = if (this@toNative.hasThumbnail()) this@toNative.thumbnail.toByteArray() else null"))
+        assertTrue(content.contains("this@toProto.thumbnail?.let { thumbnail = ByteString.copyFrom(it) }"))
+
+        File(tempDir, "default").let { dir ->
+            KotlinGenerator().generateMapper(parsedFile, dir)
+            val plain = dir.walkTopDown().single { it.name == "NativeModelMapper.kt" }.readText()
+            assertTrue(plain.contains("dataPng = this@toNative.data_png\n"), "ByteString should pass through by default")
+        }
+    }
 }
 
 /**
@@ -515,6 +831,151 @@ class GeneratorConfigTest {
         assertTrue(content.contains("#include \"my_proto.pb.h\""), "Should have extra proto include")
     }
 
+    @Test
+    fun `arena config emits arena ToProto variants`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage("AudioMessage", "com.test.AudioMessage", listOf(ParsedField("text", "text", "string", 1)))
+            ),
+            enums = emptyList()
+        )
+        val header = File(tempDir, "out.hpp")
+        val impl = File(tempDir, "out.cpp")
+
+        CppGenerator().generateHeader(parsedFile, header)
+        assertFalse(header.readText().contains("Arena"), "Arena variants must be opt-in")
+
+        val generator = CppGenerator(GeneratorConfig(emitArenaToProto = true))
+        generator.generateHeader(parsedFile, header)
+        generator.generateImplementation(parsedFile, header, impl)
+
+        val headerContent = header.readText()
+        assertTrue(headerContent.contains("#include <google/protobuf/arena.h>"))
+        assertTrue(headerContent.contains("AudioMessage* ToProto(const AudioMessage& native, google::protobuf::Arena* arena);"))
+        val implContent = impl.readText()
+        assertTrue(implContent.contains("google::protobuf::Arena::CreateMessage<AudioMessage>(arena)"))
+        assertTrue(implContent.contains("ToProto(native, result);"), "Arena variant should fill through the in-place ToProto")
+    }
+
+    @Test
+    fun `wire codec config emits direct native serialize and parse`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage(
+                    name = "RouteArc",
+                    fullName = "com.test.RouteArc",
+                    fields = listOf(
+                        ParsedField("arcKey", "arc_key", "uint64", 1, protoType = "uint64"),
+                        ParsedField("offsets", "offsets", "int32", 2, isRepeated = true, protoType = "sint32"),
+                        ParsedField("name", "name", "string", 3, isOptional = true, protoType = "string")
+                    )
+                )
+            ),
+            enums = emptyList()
+        )
+        val header = File(tempDir, "out.hpp")
+        val impl = File(tempDir, "out.cpp")
+        val generator = CppGenerator(GeneratorConfig(emitWireCodec = true))
+        generator.generateHeader(parsedFile, header)
+        generator.generateImplementation(parsedFile, header, impl)
+
+        val headerContent = header.readText()
+        assertTrue(headerContent.contains("size_t ByteSizeNative(const RouteArc& native);"))
+        assertTrue(headerContent.contains("uint8_t* SerializeNative(const RouteArc& native, uint8_t* target);"))
+        assertTrue(headerContent.contains("bool ParseNative(const uint8_t* data, size_t size, RouteArc* out);"))
+
+        val implContent = impl.readText()
+        assertTrue(implContent.contains("#include <google/protobuf/wire_format_lite.h>"))
+        assertTrue(implContent.contains("if (native.arcKey != 0) { total += 1 + WFL::UInt64Size(native.arcKey); }"),
+            "Implicit-presence scalars should be skipped at their default value")
+        assertTrue(implContent.contains("WFL::WriteSInt32NoTagToArray(item, target)"), "Repeated scalars should be packed with their exact type")
+        assertTrue(implContent.contains("case 18u: {"), "Packed encoding of field 2 should be accepted")
+        assertTrue(implContent.contains("case 16u: {"), "Unpacked encoding of field 2 should be accepted")
+        assertTrue(implContent.contains("WFL::WriteStringToArray(3, *native.name, target)"))
+        assertEquals(implContent.count { it == '{' }, implContent.count { it == '}' }, "Braces should balance")
+    }
+
+    @Test
+    fun `wire codec sizes submessages once per serialization`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage("Arc", "com.test.Arc", listOf(ParsedField("id", "id", "int32", 1, protoType = "int32"))),
+                ParsedMessage(
+                    name = "Route",
+                    fullName = "com.test.Route",
+                    fields = listOf(
+                        ParsedField("arcs", "arcs", "Arc", 1, isRepeated = true, isMessage = true, typeName = ".com.test.Arc")
+                    )
+                )
+            ),
+            enums = emptyList()
+        )
+        val header = File(tempDir, "out.hpp")
+        val impl = File(tempDir, "out.cpp")
+        val generator = CppGenerator(GeneratorConfig(emitWireCodec = true))
+        generator.generateHeader(parsedFile, header)
+        generator.generateImplementation(parsedFile, header, impl)
+        val content = impl.readText()
+
+        assertTrue(header.readText().contains("uint8_t* SerializeNative(const Route& native, const uint32_t** sizes, uint8_t* target);"))
+        assertTrue(content.contains("for (const auto& item : native.arcs) { total += 1 + CachedLengthDelimitedSize(item, sizes); }"))
+        assertTrue(content.contains(
+            "    std::vector<uint32_t> sizes;\n    ByteSizeNative(native, &sizes);\n" +
+                "    const uint32_t* next = sizes.data();\n    return SerializeNative(native, &next, target);"
+        ))
+        assertTrue(content.contains("        target = CodedOutputStream::WriteVarint32ToArray(*(*sizes)++, target);"))
+        assertFalse(content.contains("static_cast<uint32_t>(ByteSizeNative(item))"), "Length prefixes must not re-size the subtree")
+        assertTrue(
+            content.contains("uint8_t* SerializeNative(const Arc& native, uint8_t* target) {\n    return SerializeNative(native, nullptr, target);"),
+            "Messages without submessages need no size pass"
+        )
+    }
+
+    @Test
+    fun `wire codec parse rejects oversized input and drops the previous oneof member`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage(
+                    name = "Result",
+                    fullName = "com.test.Result",
+                    fields = emptyList(),
+                    oneofs = listOf(
+                        ParsedOneof(
+                            "value",
+                            listOf(
+                                ParsedField("code", "code", "int32", 1, protoType = "int32"),
+                                ParsedField("message", "message", "string", 2, protoType = "string")
+                            )
+                        )
+                    )
+                )
+            ),
+            enums = emptyList()
+        )
+        val header = File(tempDir, "out.hpp")
+        val impl = File(tempDir, "out.cpp")
+        CppGenerator(GeneratorConfig(emitWireCodec = true)).generateImplementation(parsedFile, header, impl)
+        val content = impl.readText()
+
+        assertTrue(content.contains("#include <climits>"))
+        assertTrue(content.contains(
+            "    if (size > static_cast<size_t>(INT_MAX)) return false;\n    *out = Result();\n" +
+                "    CodedInputStream input(data, static_cast<int>(size));"
+        ))
+        assertTrue(content.contains(
+            "            case 18u: {\n" +
+                "                if (out->value_case != Result::kMessage) { out->value_case = {}; out->code = {}; out->message = {}; }\n"
+        ))
+    }
+
     @Test
     fun `cpp generator emits has_() guard for optional scalar fields`() {
         val parsedFile = ParsedProtoFile(
@@ -623,15 +1084,369 @@ class GeneratorConfigTest {
     }
 
     @Test
-    fun `parser recognises oneof fields and excludes them from regular fields`() {
-        // This tests the ParsedMessage structure directly without protoc
-        val oneofField = ParsedField("error", "error", "JunctionViewError", 2, isMessage = true)
-        val oneof = ParsedOneof(name = "result", fields = listOf(oneofField))
-        val msg = ParsedMessage(
-            name = "JunctionViewResult",
-            fullName = "com.test.JunctionViewResult",
-            fields = emptyList(), // oneof members excluded from regular fields
-            oneofs = listOf(oneof)
+    fun `dense enums use lookup tables and sparse enums keep switch`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = emptyList(),
+            enums = listOf(
+                ParsedEnum("LaneDirection", "com.test.LaneDirection", listOf(
+                    ParsedEnumValue("kLaneDirectionStraight", 0),
+                    ParsedEnumValue("kLaneDirectionLeft", 1),
+                    ParsedEnumValue("kLaneDirectionRight", 2)
+                )),
+                ParsedEnum("Code", "com.test.Code", listOf(
+                    ParsedEnumValue("kCodeOk", 0),
+                    ParsedEnumValue("kCodeFailure", 100)
+                ))
+            )
+        )
+        val header = File(tempDir, "out.hpp")
+        val impl = File(tempDir, "out.cpp")
+        CppGenerator().generateImplementation(parsedFile, header, impl)
+        assertFalse(impl.readText().contains("kTable"), "Tables are opt-in, the default keeps switch")
+
+        CppGenerator(GeneratorConfig(denseEnumTables = true)).generateImplementation(parsedFile, header, impl)
+        val content = impl.readText()
+
+        val dense = content.substringAfter("LaneDirection ToNative").substringBefore("Code ToNative")
+        assertTrue(dense.contains("static constexpr LaneDirection kTable[] = {"), "Dense enum should use a table")
+        assertTrue(dense.contains("return index < 3u ? kTable[index] : LaneDirection::STRAIGHT;"), "Lookup should be bounds-checked")
+        assertTrue(dense.contains("static_assert(static_cast<int>(LaneDirection::STRAIGHT) == 0 &&"))
+        assertFalse(dense.contains("switch"), "Dense enum should not use switch")
+
+        val sparse = content.substringAfter("Code ToNative")
+        assertTrue(sparse.contains("switch (proto) {"), "Sparse enum should keep switch")
+        assertFalse(sparse.contains("kTable"), "Sparse enum should not use a table")
+    }
+
+    @Test
+    fun `inline config defines enums and small leaf messages in the header`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage("Point", "com.test.Point", listOf(
+                    ParsedField("x", "x", "int32", 1),
+                    ParsedField("y", "y", "int32", 2)
+                )),
+                ParsedMessage("Route", "com.test.Route", listOf(
+                    ParsedField("start", "start", "Point", 1, isMessage = true)
+                ))
+            ),
+            enums = listOf(
+                ParsedEnum("Side", "com.test.Side", listOf(
+                    ParsedEnumValue("kSideLeft", 0),
+                    ParsedEnumValue("kSideRight", 1)
+                ))
+            )
+        )
+        val header = File(tempDir, "out.hpp")
+        val impl = File(tempDir, "out.cpp")
+        val generator = CppGenerator(GeneratorConfig(inlineSmallConversions = true, denseEnumTables = true))
+        generator.generateHeader(parsedFile, header)
+        generator.generateImplementation(parsedFile, header, impl)
+        val headerContent = header.readText()
+        val implContent = impl.readText()
+
+        assertTrue(headerContent.contains("constexpr Side ToNative(const Side proto);"))
+        assertTrue(headerContent.contains("constexpr Side ToNative(const Side proto) {"), "Enum body should be in the header")
+        assertTrue(headerContent.contains("    constexpr Side kTable[] = {"), "constexpr functions cannot hold static locals")
+        assertTrue(headerContent.contains("inline void ToNative(const Point& proto, Point* out) {"))
+        assertTrue(headerContent.contains("inline Point ToProto(const Point& native) {"))
+        assertTrue(headerContent.contains("Route ToNative(const Route& proto);"))
+        assertFalse(headerContent.contains("inline Route"), "Messages with submessages stay out of line")
+
+        assertFalse(implContent.contains("Side ToNative(const Side proto) {"))
+        assertFalse(implContent.contains("Point ToNative(const Point& proto) {"))
+        assertTrue(implContent.contains("Route ToNative(const Route& proto) {"))
+
+        CppGenerator(GeneratorConfig(inlineSmallConversions = true, inlineMaxFieldCount = 1))
+            .generateHeader(parsedFile, header)
+        assertFalse(header.readText().contains("inline Point"), "Messages above the threshold stay out of line")
+    }
+
+    @Test
+    fun `views config emits lazy view classes`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage("AudioInstruction", "com.test.AudioInstruction", listOf(
+                    ParsedField("dataPng", "data_png", "bytes", 1),
+                    ParsedField("lanes", "lanes", "Lane", 2, isRepeated = true, isMessage = true),
+                    ParsedField("side", "side", "Side", 3, isEnum = true)
+                )),
+                ParsedMessage("Lane", "com.test.Lane", listOf(
+                    ParsedField("index", "index", "int32", 1)
+                ))
+            ),
+            enums = emptyList()
+        )
+        val header = File(tempDir, "out.hpp")
+        CppGenerator().generateHeader(parsedFile, header)
+        assertFalse(header.readText().contains("View"), "Views are off by default")
+
+        CppGenerator(GeneratorConfig(emitViews = true)).generateHeader(parsedFile, header)
+        val content = header.readText()
+        assertTrue(content.contains("class LazyRange {"))
+        assertTrue(content.contains("class AudioInstructionView {"))
+        assertTrue(content.contains("explicit AudioInstructionView(const AudioInstruction& proto) : proto_(&proto) {}"))
+        assertTrue(content.contains("inline decltype(auto) AudioInstructionView::dataPng() const { return proto_->data_png(); }"),
+            "Bytes should be returned by reference without copying")
+        assertTrue(content.contains("return MakeLazyRange(proto_->lanes(), [](const Lane& item) { return LaneView(item); });"),
+            "Repeated messages should be converted lazily")
+        assertTrue(content.contains("inline Side AudioInstructionView::side() const { return ToNative(proto_->side()); }"))
+        assertTrue(content.indexOf("class LaneView {") < content.indexOf("inline auto AudioInstructionView::lanes() const {"),
+            "All view classes should be defined before their accessors")
+    }
+
+    @Test
+    fun `batch config emits batch conversions and parallel loops above the threshold`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage("Route", "com.test.Route", listOf(
+                    ParsedField("arcs", "arcs", "Arc", 1, isRepeated = true, isMessage = true),
+                    ParsedField("names", "names", "string", 2, isRepeated = true)
+                )),
+                ParsedMessage("Arc", "com.test.Arc", listOf(
+                    ParsedField("length", "length", "int32", 1)
+                ))
+            ),
+            enums = emptyList()
+        )
+        val header = File(tempDir, "out.hpp")
+        val impl = File(tempDir, "out.cpp")
+        CppGenerator().generateImplementation(parsedFile, header, impl)
+        val sequential = impl.readText()
+        assertTrue(sequential.contains("out->names.reserve(proto.names_size());"), "Repeated fields should be pre-sized")
+        assertTrue(sequential.contains("out->mutable_names()->Reserve(static_cast<int>(native.names.size()));"))
+        assertFalse(sequential.contains("std::execution"), "No parallel code without a threshold")
+
+        val generator = CppGenerator(GeneratorConfig(emitBatchConversions = true, parallelThreshold = 256))
+        generator.generateHeader(parsedFile, header)
+        generator.generateImplementation(parsedFile, header, impl)
+        assertTrue(header.readText().contains("void ToNativeBatch(const Route* protos, size_t count, Route* out);"))
+        assertTrue(header.readText().contains("void ToProtoBatch(const Route* natives, size_t count, Route* out);"))
+        val content = impl.readText()
+        assertTrue(content.contains("#include <execution>"))
+        assertTrue(content.contains("    if (count >= 256) {"))
+        assertTrue(content.contains("std::for_each(std::execution::par, protos, protos + count, [&](const Route& proto) { ToNative(proto, &out[&proto - protos]); });"))
+        assertTrue(content.contains("    if (proto.arcs_size() >= 256) {"), "Repeated message fields should go parallel above the threshold")
+        assertTrue(content.contains("[&](Arc& item) { ToNative(proto.arcs(static_cast<int>(&item - out->arcs.data())), &item); }"))
+    }
+
+    @Test
+    fun `visitors config emits ForEach for repeated message fields`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage("JunctionViewInformationList", "com.test.JunctionViewInformationList", listOf(
+                    ParsedField(
+                        "junctionViewInformationList", "junction_view_information_list", "JunctionViewInformation", 1,
+                        isRepeated = true, isMessage = true
+                    ),
+                    ParsedField("tags", "tags", "string", 2, isRepeated = true)
+                ))
+            ),
+            enums = emptyList()
+        )
+        val header = File(tempDir, "out.hpp")
+        CppGenerator(GeneratorConfig(emitVisitors = true)).generateHeader(parsedFile, header)
+        val content = header.readText()
+
+        assertTrue(content.contains(
+            "void ForEachJunctionViewInformationList(const JunctionViewInformationList& proto, Callback&& callback) {"
+        ))
+        assertTrue(content.contains("        ToNative(element, &item);"), "Elements should be converted into one reused object")
+        assertTrue(content.contains("#ifdef __cpp_lib_generator"))
+        assertTrue(content.contains(
+            "inline std::generator<const JunctionViewInformation&> StreamJunctionViewInformationList(const JunctionViewInformationList& proto) {"
+        ))
+        assertFalse(content.contains("ForEachTags"), "Only repeated message fields get visitors")
+    }
+
+    @Test
+    fun `pmr config emits memory resource ToNative and emplaces repeated elements`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage("RoadInformation", "com.test.RoadInformation", listOf(
+                    ParsedField("names", "names", "string", 1, isRepeated = true)
+                ))
+            ),
+            enums = emptyList()
+        )
+        val header = File(tempDir, "out.hpp")
+        val impl = File(tempDir, "out.cpp")
+        val generator = CppGenerator(GeneratorConfig(emitPmrToNative = true))
+        generator.generateHeader(parsedFile, header)
+        generator.generateImplementation(parsedFile, header, impl)
+
+        assertTrue(header.readText().contains("#include <memory_resource>"))
+        assertTrue(header.readText().contains(
+            "RoadInformation ToNative(const RoadInformation& proto, std::pmr::memory_resource* resource);"
+        ))
+        val content = impl.readText()
+        assertTrue(content.contains("    RoadInformation result(RoadInformation::allocator_type{resource});"))
+        assertTrue(content.contains("out->names.emplace_back(item);"), "Elements should be constructed with the container allocator")
+        assertFalse(content.contains("push_back"))
+    }
+
+    @Test
+    fun `instrumentation config guards stats collection behind a macro`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage("Point", "com.test.Point", listOf(ParsedField("x", "x", "int32", 1)))
+            ),
+            enums = emptyList()
+        )
+        val header = File(tempDir, "out.hpp")
+        val impl = File(tempDir, "out.cpp")
+        CppGenerator().generateImplementation(parsedFile, header, impl)
+        val plain = impl.readText()
+
+        val generator = CppGenerator(GeneratorConfig(emitInstrumentation = true))
+        generator.generateHeader(parsedFile, header)
+        generator.generateImplementation(parsedFile, header, impl)
+        val headerContent = header.readText()
+        val content = impl.readText()
+
+        assertTrue(headerContent.contains("#ifdef PROTOBUF_HELPERS_ENABLE_STATS\n#include \"conversion_stats.hpp\"\n#endif"))
+        assertFalse(headerContent.contains("SnapshotConversionStats"))
+        assertTrue(content.contains("    kStatsMoveToNative_Point,"))
+        assertTrue(content.contains("    \"ToProto(const Point&)\","))
+        assertTrue(content.contains("    ConversionScope scope(kStatsToNative_Point);\n    scope.RecordBytes(proto);"))
+        assertTrue(content.contains("    scope.RecordBytes(*out);"))
+
+        // Dropping every PROTOBUF_HELPERS_ENABLE_STATS block yields the uninstrumented file
+        val stripped = content
+            .replace(Regex("#ifdef PROTOBUF_HELPERS_ENABLE_STATS\n(?:.*\n)*?#endif\n(?:\n)?"), "")
+        assertEquals(plain, stripped)
+    }
+
+    @Test
+    fun `instrumentation keeps the stats API in one shared header so helper sets link together`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage("Point", "com.test.Point", listOf(ParsedField("x", "x", "int32", 1)))
+            ),
+            enums = emptyList()
+        )
+        val header = File(tempDir, "out.hpp")
+        val impl = File(tempDir, "out.cpp")
+        val generator = CppGenerator(GeneratorConfig(emitInstrumentation = true))
+        generator.generateHeader(parsedFile, header)
+        generator.generateImplementation(parsedFile, header, impl)
+        val statsHeader = File(tempDir, "conversion_stats.hpp").readText()
+        val content = impl.readText()
+
+        assertTrue(statsHeader.contains("#ifndef PROTOBUF_HELPERS_CONVERSION_STATS_HPP"))
+        assertTrue(statsHeader.contains("inline std::vector<ConversionStats> SnapshotConversionStats() {"))
+        assertTrue(statsHeader.contains("inline void ResetConversionStats() {"))
+        assertTrue(statsHeader.contains("inline bool RegisterConversionStatsSource(ConversionStatsSource source) {"))
+
+        // No external definitions left in the helpers file: the registry sits in the anonymous namespace
+        val registry = content.substringAfter("namespace {").substringBefore("}  // namespace")
+        assertTrue(registry.contains("StatsRegistry& Registry() {"))
+        assertTrue(registry.contains("const bool kStatsRegistered = RegisterConversionStatsSource({&AppendStats, &ResetStats});"))
+        assertFalse(content.contains("std::vector<ConversionStats> SnapshotConversionStats() {"))
+
+        // Only the outermost conversion on a thread sizes its message
+        assertTrue(content.contains("topLevel_(ConversionDepth()++ == 0)"))
+        assertTrue(content.contains("        if (!topLevel_) return;\n"))
+        assertEquals(1, Regex("ByteSizeLong\\(\\)").findAll(content).count())
+    }
+
+    @Test
+    fun `parallel elements keep the nesting depth of the enclosing conversion`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage("Arc", "com.test.Arc", listOf(ParsedField("id", "id", "int32", 1))),
+                ParsedMessage(
+                    name = "Route",
+                    fullName = "com.test.Route",
+                    fields = listOf(
+                        ParsedField("arcs", "arcs", "Arc", 1, isRepeated = true, isMessage = true, typeName = ".com.test.Arc")
+                    )
+                )
+            ),
+            enums = emptyList()
+        )
+        val header = File(tempDir, "out.hpp")
+        val impl = File(tempDir, "out.cpp")
+        CppGenerator(GeneratorConfig(parallelThreshold = 64)).generateImplementation(parsedFile, header, impl)
+        val plain = impl.readText()
+        CppGenerator(GeneratorConfig(parallelThreshold = 64, emitInstrumentation = true))
+            .generateImplementation(parsedFile, header, impl)
+        val content = impl.readText()
+
+        assertTrue(content.contains("ParallelForEach(out->arcs.begin(), out->arcs.end(), [&](Arc& item) {"))
+        assertTrue(content.contains("#ifdef PROTOBUF_HELPERS_ENABLE_STATS\n    const int depth = ConversionDepth();\n#endif"))
+        assertTrue(content.contains("        const int saved = std::exchange(ConversionDepth(), depth);"))
+        assertTrue(content.contains("        ConversionDepth() = saved;"))
+        assertFalse(plain.contains("ConversionDepth"))
+        val stripped = content
+            .replace(Regex("#ifdef PROTOBUF_HELPERS_ENABLE_STATS\n(?:.*\n)*?#endif\n(?:\n)?"), "")
+        assertEquals(plain, stripped)
+    }
+
+    @Test
+    fun `byte size estimate config sizes the native struct without building the proto`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage(
+                    name = "Route",
+                    fullName = "com.test.Route",
+                    fields = listOf(
+                        ParsedField("id", "id", "uint64", 1, protoType = "fixed64"),
+                        ParsedField("arcs", "arcs", "Arc", 2, isRepeated = true, isMessage = true, typeName = ".com.test.Arc")
+                    )
+                )
+            ),
+            enums = emptyList()
+        )
+        val header = File(tempDir, "out.hpp")
+        val impl = File(tempDir, "out.cpp")
+        val generator = CppGenerator(GeneratorConfig(emitByteSizeEstimate = true))
+        generator.generateHeader(parsedFile, header)
+        generator.generateImplementation(parsedFile, header, impl)
+
+        assertTrue(header.readText().contains("size_t EstimatedByteSize(const Route& native);"))
+        val content = impl.readText()
+        assertTrue(content.contains("if (native.id != 0) { total += 1 + WFL::kFixed64Size; }"))
+        assertTrue(content.contains("total += 1 + WFL::LengthDelimitedSize(EstimatedByteSize(item));"),
+            "Submessages should recurse into the estimate")
+        assertFalse(content.contains("ByteSizeNative"), "The wire codec should stay off")
+
+        val withCodec = CppGenerator(GeneratorConfig(emitByteSizeEstimate = true, emitWireCodec = true))
+        withCodec.generateImplementation(parsedFile, header, impl)
+        assertTrue(impl.readText().contains("size_t EstimatedByteSize(const Route& native) {\n    return ByteSizeNative(native);\n}"),
+            "With the wire codec on, the estimate should reuse ByteSizeNative")
+    }
+
+    @Test
+    fun `parser recognises oneof fields and excludes them from regular fields`() {
+        // This tests the ParsedMessage structure directly without protoc
+        val oneofField = ParsedField("error", "error", "JunctionViewError", 2, isMessage = true)
+        val oneof = ParsedOneof(name = "result", fields = listOf(oneofField))
+        val msg = ParsedMessage(
+            name = "JunctionViewResult",
+            fullName = "com.test.JunctionViewResult",
+            fields = emptyList(), // oneof members excluded from regular fields
+            oneofs = listOf(oneof)
         )
         assertEquals(0, msg.fields.size, "Oneof members should not appear in regular fields")
         assertEquals(1, msg.oneofs.size, "Should have one oneof")
@@ -666,3 +1481,430 @@ class GeneratorConfigTest {
     }
 }
 
+/**
+ * Unit tests for CppBenchmarkGenerator
+ */
+class CppBenchmarkGeneratorTest {
+
+    @TempDir
+    lateinit var tempDir: File
+
+    private val parsedFile = ParsedProtoFile(
+        packageName = "com.test",
+        protoPackage = "com.test",
+        messages = listOf(
+            ParsedMessage("Route", "com.test.Route", listOf(
+                ParsedField("name", "name", "string", 1),
+                ParsedField("side", "side", "Side", 2, isEnum = true, typeName = ".com.test.Side"),
+                ParsedField("arcs", "arcs", "Route", 3, isRepeated = true, isMessage = true)
+            ))
+        ),
+        enums = listOf(
+            ParsedEnum("Side", "com.test.Side", listOf(
+                ParsedEnumValue("kSideLeft", 0),
+                ParsedEnumValue("kSideRight", 1)
+            ))
+        )
+    )
+
+    @Test
+    fun `benchmark source populates inputs and covers every conversion path`() {
+        val output = File(tempDir, "route_benchmark.cpp")
+        CppBenchmarkGenerator().generateBenchmark(parsedFile, File(tempDir, "protobuf_helpers.hpp"), output)
+        val content = output.readText()
+
+        assertTrue(content.contains("#include \"protobuf_helpers.hpp\""))
+        assertTrue(content.contains("using namespace protobuf_helpers;"))
+        assertTrue(content.contains("    proto->set_name(std::string(\"benchmark sample text\"));"))
+        assertTrue(content.contains("    proto->set_side(Side::kSideRight);"), "Enums should get a non-default value")
+        assertTrue(
+            content.contains("if (depth > 0) { for (int i = 0; i < kRepeatedCount; ++i) { Populate(proto->add_arcs(), depth - 1); } }"),
+            "Recursive messages should stop at the populate depth"
+        )
+        listOf("ToNative", "ToProto", "RoundTrip", "ParseToNative", "ToProtoSerialize").forEach { case ->
+            assertTrue(content.contains("BENCHMARK(BM_Route_$case);"), "Missing $case benchmark")
+        }
+        assertTrue(content.trimEnd().endsWith("BENCHMARK_MAIN();"))
+    }
+
+    @Test
+    fun `cmake snippet builds the benchmark against the generated helpers`() {
+        val output = File(tempDir, "route_benchmark.cmake")
+        CppBenchmarkGenerator().generateCMake(
+            File(tempDir, "route_benchmark.cpp"),
+            File(tempDir, "protobuf_helpers.cpp"),
+            output
+        )
+        val content = output.readText()
+
+        assertTrue(content.contains("add_executable(route_benchmark"))
+        assertTrue(content.contains("    \${CMAKE_CURRENT_LIST_DIR}/protobuf_helpers.cpp"))
+        assertTrue(content.contains(
+            "target_link_libraries(route_benchmark PRIVATE \${PROTOBUF_HELPERS_PROTO_LIBRARY} benchmark::benchmark)"
+        ))
+    }
+}
+
+/**
+ * Unit tests for KotlinBenchmarkGenerator
+ */
+class KotlinBenchmarkGeneratorTest {
+
+    @TempDir
+    lateinit var tempDir: File
+
+    private val parsedFile = ParsedProtoFile(
+        packageName = "com.test",
+        protoPackage = "com.test",
+        messages = listOf(
+            ParsedMessage("Route", "com.test.Route", listOf(
+                ParsedField("name", "name", "string", 1),
+                ParsedField("side", "side", "Side", 2, isEnum = true, typeName = ".com.test.Side"),
+                ParsedField("arcs", "arcs", "Route", 3, isRepeated = true, isMessage = true)
+            ))
+        ),
+        enums = listOf(
+            ParsedEnum("Side", "com.test.Side", listOf(
+                ParsedEnumValue("kSideLeft", 0),
+                ParsedEnumValue("kSideRight", 1)
+            ))
+        )
+    )
+
+    @Test
+    fun `jmh benchmark populates inputs and measures mappers and serialization`() {
+        KotlinBenchmarkGenerator().generateBenchmark(parsedFile, "RouteMapperBenchmark", tempDir)
+        val content = File(tempDir, "com/test/RouteMapperBenchmark.kt").readText()
+
+        assertTrue(content.contains("@State(Scope.Benchmark)"))
+        assertTrue(content.contains("public open class RouteMapperBenchmark"), "JMH subclasses the benchmark class")
+        assertTrue(content.contains("builder.setName(\"benchmark sample text\")"))
+        assertTrue(content.contains("builder.setSide(Side.kSideRight)"), "Enums should get a non-default value")
+        assertTrue(content.contains("if (depth > 0) repeat(8)"), "Recursive messages should stop at the populate depth")
+        assertTrue(content.contains("routeNative = routeProto.toNative()"))
+        listOf("ToProto", "ToNative", "ToByteArray", "ParseFrom").forEach { case ->
+            assertTrue(content.contains("public fun route$case()"), "Missing $case benchmark")
+        }
+        assertTrue(content.contains("Route.parseFrom(routeBytes)"))
+    }
+
+    @Test
+    fun `gradle script adds the benchmark to a jmh source set with the gc profiler`() {
+        val output = File(tempDir, "route_jmh.gradle.kts")
+        KotlinBenchmarkGenerator().generateGradle(File(tempDir, "jmh"), output)
+        val content = output.readText()
+
+        assertTrue(
+            content.contains("apply(plugin = \"java\")\napply<me.champeau.jmh.JMHPlugin>()"),
+            "The plugin must be applied by type, after java"
+        )
+        assertFalse(content.contains("apply(plugin = \"me.champeau.jmh\")"), "A script plugin cannot resolve the id")
+        assertTrue(content.contains("java.srcDir(File(buildscript.sourceFile!!.parentFile, \"jmh\"))"))
+        assertTrue(content.contains("profilers.add(\"gc\")"))
+        assertFalse(content.contains("android"), "The benchmark must run without Android")
+    }
+}
+
+/**
+ * Unit tests for JniGenerator and the matching Kotlin bindings
+ */
+class JniGeneratorTest {
+
+    @TempDir
+    lateinit var tempDir: File
+
+    private val parsedFile = ParsedProtoFile(
+        packageName = "com.test.junction_view",
+        protoPackage = "com.test.junction_view",
+        messages = emptyList(),
+        enums = emptyList(),
+        services = listOf(
+            ParsedService(
+                "JunctionViewService",
+                "com.test.junction_view.JunctionViewService",
+                listOf(
+                    ParsedMethod(
+                        "GenerateJunctionViews",
+                        ".com.test.junction_view.JunctionViewRequest",
+                        ".com.test.junction_view.JunctionViewResult"
+                    )
+                )
+            )
+        )
+    )
+
+    @Test
+    fun `glue declares the native hook and exports a mangled entry point`() {
+        val output = File(tempDir, "junction_view_jni.cpp")
+        JniGenerator().generateGlue(parsedFile, output)
+        val content = output.readText()
+
+        assertTrue(content.contains(
+            "void GenerateJunctionViews(jlong handle, const JunctionViewRequest& request, JunctionViewResult* response);"
+        ))
+        assertTrue(
+            content.contains("Java_com_test_junction_1view_JunctionViewServiceJni_nativeGenerateJunctionViews(JNIEnv* env,"),
+            "Underscores in the package should be escaped"
+        )
+        assertTrue(content.contains("    if (!ParseDirect(env, request, requestSize, &requestProto)) {"))
+        assertTrue(content.contains("        protobuf_helpers::GenerateJunctionViews(handle, requestProto, &responseProto);"))
+        assertTrue(content.contains("    return SerializeDirect(env, responseProto, response);"))
+        assertFalse(content.contains("jbyteArray"))
+        assertFalse(content.contains("GetDirectBufferAddress(target))"), "The response address must be checked before use")
+    }
+
+    @Test
+    fun `glue rejects buffers that are not direct with IllegalArgumentException`() {
+        val output = File(tempDir, "junction_view_jni.cpp")
+        JniGenerator().generateGlue(parsedFile, output)
+        val content = output.readText()
+
+        val entryCheck = content.indexOf(
+            "    if (env->GetDirectBufferAddress(request) == nullptr || env->GetDirectBufferAddress(response) == nullptr) {"
+        )
+        assertTrue(entryCheck in 0 until content.indexOf("    if (!ParseDirect(env, request, requestSize, &requestProto)) {"))
+        assertTrue(content.contains("\"java/lang/IllegalArgumentException\", \"Request and response must be direct buffers\""))
+        assertTrue(content.contains(
+            "    if (data == nullptr) {\n" +
+                "        ThrowJava(env, \"java/lang/IllegalArgumentException\", \"Response buffer is not a direct buffer\");\n" +
+                "        return nullptr;\n" +
+                "    }\n" +
+                "    message.SerializeWithCachedSizesToArray(data);"
+        ))
+        assertEquals(content.count { it == '{' }, content.count { it == '}' }, "Braces should balance")
+    }
+
+    @Test
+    fun `kotlin bindings reuse direct buffers and declare the external function`() {
+        KotlinGenerator().generateNativeBindings(parsedFile, tempDir)
+        val content = tempDir.walkTopDown().single { it.name == "JunctionViewServiceJni.kt" }.readText()
+
+        assertTrue(content.contains("internal class JunctionViewServiceJni("))
+        assertTrue(content.contains("private var requestBuffer: ByteBuffer = ByteBuffer.allocateDirect(initialCapacity)"))
+        assertTrue(content.contains("public fun generateJunctionViews("))
+        assertTrue(content.contains("request: JunctionViewRequest"))
+        assertTrue(content.contains("return JunctionViewResult.parseFrom(responseBuffer)"))
+        assertTrue(content.contains("responseBuffer = nativeGenerateJunctionViews("))
+        assertTrue(content.contains("private external fun nativeGenerateJunctionViews("))
+        assertFalse(content.contains("ByteArray"), "No payload should be copied through the heap")
+    }
+
+    @Test
+    fun `native client runs calls under the read lock and swaps handles under the write lock`() {
+        KotlinGenerator().generateNativeClient(parsedFile, tempDir)
+        val content = tempDir.walkTopDown().single { it.name == "NativeJunctionViewServiceClient.kt" }.readText()
+
+        assertTrue(content.contains("internal class NativeJunctionViewServiceClient("))
+        assertTrue(content.contains("private val handleLock: ReentrantReadWriteLock = ReentrantReadWriteLock()"))
+        assertTrue(
+            content.contains("private val bindingsPool: ArrayBlockingQueue<JunctionViewServiceJni> = ArrayBlockingQueue(4)"),
+            "Idle buffers should be bounded, not kept per thread"
+        )
+        assertFalse(content.contains("ThreadLocal"))
+        assertTrue(content.contains("handleLock.read {"))
+        assertTrue(content.contains("val bindings = acquireBindings()"))
+        assertTrue(Regex("bindings\\.generateJunctionViews\\(handle, request\\)\\s+} finally \\{\\s+releaseBindings\\(bindings\\)").containsMatchIn(content))
+        assertTrue(content.contains("if (handle != 0L && bindings.retainedBytes <= 1048576) bindingsPool.offer(bindings)"))
+        assertEquals(2, Regex("bindingsPool\\.clear\\(\\)").findAll(content).count(), "replaceHandle and close should drop idle buffers")
+        assertEquals(2, Regex("handleLock\\.write \\{").findAll(content).count(), "Only replaceHandle and close should take the write lock")
+        assertFalse(content.contains("synchronized"))
+    }
+
+    @Test
+    fun `suspend client config runs calls on a bounded dispatcher and skips parsing when cancelled`() {
+        KotlinGenerator(KotlinGeneratorConfig(emitSuspendClient = true, suspendParallelism = 2))
+            .generateNativeClient(parsedFile, tempDir)
+        val content = tempDir.walkTopDown().single { it.name == "NativeJunctionViewServiceClient.kt" }.readText()
+
+        assertTrue(content.contains("Dispatchers.IO.limitedParallelism(2)"))
+        assertTrue(content.contains("public suspend fun generateJunctionViewsSuspending("))
+        assertTrue(content.contains("withContext(dispatcher) {"))
+        assertTrue(content.contains("if (handle != 0L) bindings.callGenerateJunctionViews(handle, request) else null"))
+        assertTrue(
+            content.indexOf("releaseBindings(bindings)", content.indexOf("suspend fun")) >
+                content.indexOf("JunctionViewResult.parseFrom(response)"),
+            "The instance holding the response must stay borrowed until it is parsed"
+        )
+        assertTrue(
+            content.indexOf("ensureActive()") in 0 until content.indexOf("JunctionViewResult.parseFrom(response)"),
+            "Cancellation should be checked before parsing"
+        )
+
+        File(tempDir, "blocking").let { dir ->
+            KotlinGenerator().generateNativeClient(parsedFile, dir)
+            val blocking = dir.walkTopDown().single { it.name == "NativeJunctionViewServiceClient.kt" }.readText()
+            assertFalse(blocking.contains("kotlinx.coroutines"), "Coroutines should only be needed when asked for")
+        }
+    }
+}
+
+/**
+ * Unit tests for CorpusGenerator
+ */
+class CorpusGeneratorTest {
+
+    @TempDir
+    lateinit var tempDir: File
+
+    private val routeDescriptor: Descriptors.Descriptor by lazy {
+        val arc = DescriptorProtos.DescriptorProto.newBuilder()
+            .setName("RouteArc")
+            .addField(field("length", 1, DescriptorProtos.FieldDescriptorProto.Type.TYPE_INT32))
+            .build()
+        val route = DescriptorProtos.DescriptorProto.newBuilder()
+            .setName("Route")
+            .addField(field("name", 1, DescriptorProtos.FieldDescriptorProto.Type.TYPE_STRING))
+            .addField(field("image", 2, DescriptorProtos.FieldDescriptorProto.Type.TYPE_BYTES))
+            .addField(
+                field("arcs", 3, DescriptorProtos.FieldDescriptorProto.Type.TYPE_MESSAGE)
+                    .setLabel(DescriptorProtos.FieldDescriptorProto.Label.LABEL_REPEATED)
+                    .setTypeName(".test.RouteArc")
+            )
+            .addOneofDecl(DescriptorProtos.OneofDescriptorProto.newBuilder().setName("target"))
+            .addField(field("stop", 4, DescriptorProtos.FieldDescriptorProto.Type.TYPE_INT32).setOneofIndex(0))
+            .addField(field("detour", 5, DescriptorProtos.FieldDescriptorProto.Type.TYPE_STRING).setOneofIndex(0))
+            .build()
+        val file = DescriptorProtos.FileDescriptorProto.newBuilder()
+            .setName("route.proto")
+            .setPackage("test")
+            .setSyntax("proto3")
+            .addMessageType(arc)
+            .addMessageType(route)
+            .build()
+        Descriptors.FileDescriptor.buildFrom(file, emptyArray()).findMessageTypeByName("Route")
+    }
+
+    private fun field(name: String, number: Int, type: DescriptorProtos.FieldDescriptorProto.Type) =
+        DescriptorProtos.FieldDescriptorProto.newBuilder()
+            .setName(name)
+            .setNumber(number)
+            .setType(type)
+            .setLabel(DescriptorProtos.FieldDescriptorProto.Label.LABEL_OPTIONAL)
+
+    @Test
+    fun `corpus messages follow the size knobs`() {
+        val config = CorpusConfig(repeatedCounts = mapOf("arcs" to 500), stringLength = 7, bytesLength = 2048)
+        val message = CorpusGenerator(config).buildMessage(routeDescriptor)
+
+        assertEquals(500, message.getRepeatedFieldCount(routeDescriptor.findFieldByName("arcs")))
+        assertEquals(7, (message.getField(routeDescriptor.findFieldByName("name")) as String).length)
+        assertEquals(2048, (message.getField(routeDescriptor.findFieldByName("image")) as ByteString).size())
+    }
+
+    @Test
+    fun `corpus oneofs follow the member weights`() {
+        val target = routeDescriptor.realOneofs.single()
+        fun pickedMembers(config: CorpusConfig) = CorpusGenerator(config).let { generator ->
+            List(400) { generator.buildMessage(routeDescriptor).getOneofFieldDescriptor(target)?.name }
+        }
+
+        val skewed = pickedMembers(CorpusConfig(repeatedCount = 0, oneofWeights = mapOf("test.Route.stop" to 3.0)))
+        assertTrue(skewed.count { it == "stop" } in 250..350, "stop should be picked about 3 times in 4")
+        assertEquals(setOf("stop", "detour"), skewed.toSet())
+
+        assertEquals(setOf("detour"), pickedMembers(CorpusConfig(repeatedCount = 0, oneofWeights = mapOf("stop" to 0.0))).toSet())
+        assertEquals(
+            setOf<String?>(null),
+            pickedMembers(CorpusConfig(repeatedCount = 0, oneofWeights = mapOf("stop" to 0.0, "detour" to 0.0))).toSet(),
+            "A oneof whose members all weigh 0 should stay unset"
+        )
+        assertEquals(setOf("detour"), pickedMembers(CorpusConfig(repeatedCount = 0, oneofMember = 1)).toSet())
+    }
+
+    @Test
+    fun `corpus file holds length-delimited messages and is reproducible`() {
+        val first = File(tempDir, "first.bin")
+        val second = File(tempDir, "second.bin")
+        CorpusGenerator(CorpusConfig(repeatedCount = 3)).writeCorpus(routeDescriptor, 10, first)
+        CorpusGenerator(CorpusConfig(repeatedCount = 3)).writeCorpus(routeDescriptor, 10, second)
+
+        assertTrue(first.readBytes().contentEquals(second.readBytes()), "Same seed should give the same corpus")
+        val messages = first.inputStream().use { input ->
+            generateSequence {
+                val builder = DynamicMessage.newBuilder(routeDescriptor)
+                if (builder.mergeDelimitedFrom(input)) builder.build() else null
+            }.toList()
+        }
+        assertEquals(10, messages.size)
+        assertEquals(3, messages.first().getRepeatedFieldCount(routeDescriptor.findFieldByName("arcs")))
+    }
+}
+
+/**
+ * Unit tests for incremental output writing
+ */
+class OutputFilesTest {
+
+    @TempDir
+    lateinit var tempDir: File
+
+    @Test
+    fun `unchanged content is not rewritten`() {
+        val file = File(tempDir, "protobuf_helpers.hpp")
+        assertTrue(writeIfChanged(file, "struct Route {};\n"))
+        file.setLastModified(1_000_000L)
+
+        assertFalse(writeIfChanged(file, "struct Route {};\n"))
+        assertEquals(1_000_000L, file.lastModified(), "Identical output must keep its mtime")
+        assertTrue(writeIfChanged(file, "struct Route { int id; };\n"))
+    }
+
+    @Test
+    fun `generated Kotlin is identical across runs`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage("Route", "com.test.Route", listOf(ParsedField("name", "name", "string", 1)))
+            ),
+            enums = emptyList()
+        )
+        KotlinGenerator().generateMapper(parsedFile, tempDir)
+        val file = tempDir.walkTopDown().single { it.name == "NativeModelMapper.kt" }
+        val first = file.readText()
+        file.setLastModified(1_000_000L)
+
+        KotlinGenerator().generateMapper(parsedFile, tempDir)
+        assertEquals(first, file.readText())
+        assertEquals(1_000_000L, file.lastModified())
+    }
+
+    @Test
+    fun `generator version includes a digest of the generator code`() {
+        assertTrue(
+            Regex(".+\\+[0-9a-f]{64}").matches(GENERATOR_VERSION),
+            "A rebuilt generator must not reuse outputs of the old one: $GENERATOR_VERSION"
+        )
+    }
+
+    @Test
+    fun `manifest only covers the files the run wrote`() {
+        val parsedFile = ParsedProtoFile(
+            packageName = "com.test",
+            protoPackage = "com.test",
+            messages = listOf(
+                ParsedMessage("Route", "com.test.Route", listOf(ParsedField("name", "name", "string", 1)))
+            ),
+            enums = emptyList()
+        )
+        File(tempDir, "routing/protobuf_helpers.cpp").apply { parentFile.mkdirs() }.writeText("// other proto\n")
+        File(tempDir, "notes.txt").writeText("user file\n")
+        val written = CppGenerator().generateHeader(parsedFile, File(tempDir, "protobuf_helpers.hpp")) +
+            KotlinGenerator().generateMapper(parsedFile, tempDir)
+
+        val manifest = GenerationManifest.of(tempDir, "abc", written)
+        assertEquals(setOf("protobuf_helpers.hpp", "com/test/NativeModelMapper.kt"), manifest.outputs.keys)
+    }
+
+    @Test
+    fun `manifest is stale when the inputs or an output change`() {
+        File(tempDir, "protobuf_helpers.cpp").writeText("// generated\n")
+        GenerationManifest.of(tempDir, "abc", listOf(File(tempDir, "protobuf_helpers.cpp"))).write(tempDir)
+        val manifest = GenerationManifest.read(tempDir)!!
+
+        assertTrue(manifest.isUpToDate(tempDir, "abc"))
+        assertFalse(manifest.isUpToDate(tempDir, "def"), "A new input hash must regenerate")
+        File(tempDir, "protobuf_helpers.cpp").writeText("// edited\n")
+        assertFalse(manifest.isUpToDate(tempDir, "abc"), "An edited output must regenerate")
+    }
+}
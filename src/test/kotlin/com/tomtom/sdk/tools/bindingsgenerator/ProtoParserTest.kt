@@ -5,6 +5,7 @@ import org.junit.jupiter.api.io.TempDir
 import org.junit.jupiter.api.Assumptions
 import java.io.File
 import kotlin.test.assertEquals
+import kotlin.test.assertFailsWith
 import kotlin.test.assertFalse
 import kotlin.test.assertNotNull
 import kotlin.test.assertTrue
@@ -363,5 +364,109 @@ class ProtoParserTest {
         assertEquals("Result", msg.oneofs.first().name)
         assertEquals(2, msg.oneofs.first().fields.size, "Oneof should have two alternatives")
     }
+
+    @Test
+    fun `test parseProtoFile recognises unary service methods`() {
+        requireProtoc()
+
+        val protoContent = """
+            syntax = "proto3";
+            package com.test;
+
+            message Request {}
+            message Response {}
+            service JunctionViewService {
+              rpc GenerateJunctionViews(Request) returns (Response);
+              rpc Watch(Request) returns (stream Response);
+            }
+        """.trimIndent()
+
+        val protoFile = File(tempDir, "service_test.proto")
+        protoFile.writeText(protoContent)
+
+        val result = ProtoParser().parseProtoFile(protoFile, emptyList())
+
+        val service = result.services.single()
+        assertEquals("com.test.JunctionViewService", service.fullName)
+        assertEquals(
+            listOf(ParsedMethod("GenerateJunctionViews", ".com.test.Request", ".com.test.Response")),
+            service.methods,
+            "Streaming rpcs should be skipped"
+        )
+    }
+
+    @Test
+    fun `test compileDescriptorSet compiles a batch in one protoc run`() {
+        requireProtoc()
+
+        File(tempDir, "common").mkdirs()
+        File(tempDir, "common/base.proto").writeText("""
+            syntax = "proto3";
+            package com.test;
+
+            message Base { int32 id = 1; }
+        """.trimIndent())
+        File(tempDir, "route.proto").writeText("""
+            syntax = "proto3";
+            package com.test;
+
+            import "common/base.proto";
+
+            message Route { Base base = 1; }
+        """.trimIndent())
+
+        val parser = ProtoParser()
+        val protoFiles = listOf(File(tempDir, "common/base.proto"), File(tempDir, "route.proto"))
+        val names = protoFiles.map { parser.protoName(it, listOf(tempDir)) }
+        assertEquals(listOf("common/base.proto", "route.proto"), names)
+
+        val descriptorSet = parser.compileDescriptorSet(protoFiles, listOf(tempDir))
+        assertEquals(names, descriptorSet.fileList.map { it.name }, "Each file should appear once")
+        assertEquals("Base", parser.parseDescriptorSet(descriptorSet, "common/base.proto").messages.single().name)
+        assertEquals("Route", parser.parseDescriptorSet(descriptorSet, "route.proto").messages.single().name)
+    }
+
+    @Test
+    fun `test parseDescriptorSet rejects a file that is not in the set`() {
+        requireProtoc()
+        val protoFile = File(tempDir, "route.proto")
+        protoFile.writeText("""
+            syntax = "proto3";
+            package com.test;
+
+            message Route { int32 id = 1; }
+        """.trimIndent())
+
+        val parser = ProtoParser()
+        val descriptorSet = parser.compileDescriptorSet(protoFile, emptyList())
+        val error = assertFailsWith<IllegalArgumentException> { parser.parseDescriptorSet(descriptorSet, "missing.proto") }
+        assertTrue(error.message!!.contains("missing.proto"), "Should name the missing file")
+        assertTrue(error.message!!.contains("route.proto"), "Should list the available files")
+    }
+
+    @Test
+    fun `test parseProtoFile finds a file nested below the include directory`() {
+        requireProtoc()
+        File(tempDir, "routing").mkdirs()
+        File(tempDir, "routing/base.proto").writeText("""
+            syntax = "proto3";
+            package com.test;
+
+            message Base { int32 id = 1; }
+        """.trimIndent())
+        val protoFile = File(tempDir, "routing/route.proto")
+        protoFile.writeText("""
+            syntax = "proto3";
+            package com.test;
+
+            import "routing/base.proto";
+
+            message Route { Base base = 1; }
+        """.trimIndent())
+
+        val parser = ProtoParser()
+        assertEquals("Route", parser.parseProtoFile(protoFile, listOf(tempDir)).messages.single().name)
+        assertEquals("routing/route.proto", parser.loadFileDescriptor(protoFile, listOf(tempDir)).name)
+    }
 }
 
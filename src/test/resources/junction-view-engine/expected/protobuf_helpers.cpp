@@ -51,54 +51,119 @@ JunctionViewDaylightType ToProto(const JunctionViewDaylightType native) {
     }
 }
 
-JunctionViewInformationList ToNative(const JunctionViewInformationList proto) {
+JunctionViewInformationList ToNative(const JunctionViewInformationList& proto) {
     JunctionViewInformationList result;
-    for (const auto& item : proto.junction_view_information_list()) { result.junctionViewInformationList.push_back(ToNative(item)); }
+    ToNative(proto, &result);
     return result;
 }
 
+void ToNative(const JunctionViewInformationList& proto, JunctionViewInformationList* out) {
+    out->junctionViewInformationList.resize(proto.junction_view_information_list_size());
+    for (int i = 0; i < proto.junction_view_information_list_size(); ++i) { ToNative(proto.junction_view_information_list(i), &out->junctionViewInformationList[i]); }
+}
+
+JunctionViewInformationList ToNative(JunctionViewInformationList&& proto) {
+    JunctionViewInformationList result;
+    ToNative(std::move(proto), &result);
+    return result;
+}
+
+void ToNative(JunctionViewInformationList&& proto, JunctionViewInformationList* out) {
+    out->junctionViewInformationList.resize(proto.junction_view_information_list_size());
+    for (int i = 0; i < proto.junction_view_information_list_size(); ++i) { ToNative(std::move(*proto.mutable_junction_view_information_list(i)), &out->junctionViewInformationList[i]); }
+}
+
 JunctionViewInformationList ToProto(const JunctionViewInformationList& native) {
     JunctionViewInformationList result;
+    ToProto(native, &result);
+    return result;
+}
+
+void ToProto(const JunctionViewInformationList& native, JunctionViewInformationList* out) {
+    out->Clear();
+    out->mutable_junction_view_information_list()->Reserve(static_cast<int>(native.junctionViewInformationList.size()));
     for (const auto& item : native.junctionViewInformationList) {
-        result.add_junction_view_information_list(item);
+        ToProto(item, out->add_junction_view_information_list());
     }
+}
+
+JunctionViewInformation ToNative(const JunctionViewInformation& proto) {
+    JunctionViewInformation result;
+    ToNative(proto, &result);
     return result;
 }
 
-JunctionViewInformation ToNative(const JunctionViewInformation proto) {
+void ToNative(const JunctionViewInformation& proto, JunctionViewInformation* out) {
+    out->dataPng = proto.data_png();
+    out->type = ToNative(proto.type());
+    out->daylightType = ToNative(proto.daylight_type());
+    out->startRouteOffsetInCentimeters = proto.start_route_offset_in_centimeters();
+    out->endRouteOffsetInCentimeters = proto.end_route_offset_in_centimeters();
+}
+
+JunctionViewInformation ToNative(JunctionViewInformation&& proto) {
     JunctionViewInformation result;
-    result.dataPng = proto.data_png();
-    result.type = ToNative(proto.type());
-    result.daylightType = ToNative(proto.daylight_type());
-    result.startRouteOffsetInCentimeters = proto.start_route_offset_in_centimeters();
-    result.endRouteOffsetInCentimeters = proto.end_route_offset_in_centimeters();
+    ToNative(std::move(proto), &result);
     return result;
 }
 
+void ToNative(JunctionViewInformation&& proto, JunctionViewInformation* out) {
+    out->dataPng = std::move(*proto.mutable_data_png());
+    out->type = ToNative(proto.type());
+    out->daylightType = ToNative(proto.daylight_type());
+    out->startRouteOffsetInCentimeters = proto.start_route_offset_in_centimeters();
+    out->endRouteOffsetInCentimeters = proto.end_route_offset_in_centimeters();
+}
+
 JunctionViewInformation ToProto(const JunctionViewInformation& native) {
     JunctionViewInformation result;
-    result.set_data_png(native.dataPng);
-    result.set_type(ToProto(native.type));
-    result.set_daylight_type(ToProto(native.daylightType));
-    result.set_start_route_offset_in_centimeters(native.startRouteOffsetInCentimeters);
-    result.set_end_route_offset_in_centimeters(native.endRouteOffsetInCentimeters);
+    ToProto(native, &result);
     return result;
 }
 
-JunctionViewError ToNative(const JunctionViewError proto) {
+void ToProto(const JunctionViewInformation& native, JunctionViewInformation* out) {
+    out->Clear();
+    out->set_data_png(native.dataPng);
+    out->set_type(ToProto(native.type));
+    out->set_daylight_type(ToProto(native.daylightType));
+    out->set_start_route_offset_in_centimeters(native.startRouteOffsetInCentimeters);
+    out->set_end_route_offset_in_centimeters(native.endRouteOffsetInCentimeters);
+}
+
+JunctionViewError ToNative(const JunctionViewError& proto) {
     JunctionViewError result;
-    result.errorType = ToNative(proto.errorType());
-    result.message = proto.message();
+    ToNative(proto, &result);
     return result;
 }
 
+void ToNative(const JunctionViewError& proto, JunctionViewError* out) {
+    out->errorType = ToNative(proto.errorType());
+    out->message = proto.message();
+}
+
+JunctionViewError ToNative(JunctionViewError&& proto) {
+    JunctionViewError result;
+    ToNative(std::move(proto), &result);
+    return result;
+}
+
+void ToNative(JunctionViewError&& proto, JunctionViewError* out) {
+    out->errorType = ToNative(proto.errorType());
+    out->message = std::move(*proto.mutable_message());
+}
+
 JunctionViewError ToProto(const JunctionViewError& native) {
     JunctionViewError result;
-    result.set_errorType(ToProto(native.errorType));
-    result.set_message(native.message);
+    ToProto(native, &result);
     return result;
 }
 
+void ToProto(const JunctionViewError& native, JunctionViewError* out) {
+    out->Clear();
+    out->set_errorType(ToProto(native.errorType));
+    out->set_message(native.message);
+}
+
 ErrorType ToNative(const JunctionViewError_ErrorType proto) {
     switch (proto) {
         case JunctionViewError_ErrorType::kArcVersionMismatch: return ErrorType::KARCVERSIONMISMATCH;
@@ -115,25 +180,54 @@ JunctionViewError_ErrorType ToProto(const ErrorType native) {
     }
 }
 
-JunctionViewResult ToNative(const JunctionViewResult proto) {
+JunctionViewResult ToNative(const JunctionViewResult& proto) {
     JunctionViewResult result;
+    ToNative(proto, &result);
+    return result;
+}
+
+void ToNative(const JunctionViewResult& proto, JunctionViewResult* out) {
+    out->Result_case = {};
+    out->junctionViews = {};
+    out->error = {};
     switch (proto.Result_case()) {
-        case JunctionViewResult::kJunctionViews: result.junctionViews = proto.junction_views(); break;
-        case JunctionViewResult::kError: result.error = proto.error(); break;
+        case JunctionViewResult::kJunctionViews: ToNative(proto.junction_views(), &out->junctionViews); out->Result_case = JunctionViewResult::kJunctionViews; break;
+        case JunctionViewResult::kError: ToNative(proto.error(), &out->error); out->Result_case = JunctionViewResult::kError; break;
         default: break;
     }
+}
+
+JunctionViewResult ToNative(JunctionViewResult&& proto) {
+    JunctionViewResult result;
+    ToNative(std::move(proto), &result);
     return result;
 }
 
+void ToNative(JunctionViewResult&& proto, JunctionViewResult* out) {
+    out->Result_case = {};
+    out->junctionViews = {};
+    out->error = {};
+    switch (proto.Result_case()) {
+        case JunctionViewResult::kJunctionViews: ToNative(std::move(*proto.mutable_junction_views()), &out->junctionViews); out->Result_case = JunctionViewResult::kJunctionViews; break;
+        case JunctionViewResult::kError: ToNative(std::move(*proto.mutable_error()), &out->error); out->Result_case = JunctionViewResult::kError; break;
+        default: break;
+    }
+}
+
 JunctionViewResult ToProto(const JunctionViewResult& native) {
     JunctionViewResult result;
+    ToProto(native, &result);
+    return result;
+}
+
+void ToProto(const JunctionViewResult& native, JunctionViewResult* out) {
+    out->Clear();
     if (native.Result_case == JunctionViewResult::kJunctionViews) {
-        result.set_junction_views(native.junctionViews);
+        ToProto(native.junctionViews, out->mutable_junction_views());
     }
     if (native.Result_case == JunctionViewResult::kError) {
-        result.set_error(native.error);
+        ToProto(native.error, out->mutable_error());
     }
-    return result;
 }
 
 }  // namespace protobuf_helpers
@@ -15,6 +15,7 @@
 #define PROTOBUF_HELPERS_HPP
 
 #include <string>
+#include <utility>
 #include <vector>
 
 // Forward declarations
@@ -34,24 +35,40 @@ JunctionViewDaylightType ToNative(const JunctionViewDaylightType proto);
 JunctionViewDaylightType ToProto(const JunctionViewDaylightType native);
 
 // Conversion functions for JunctionViewInformationList
-JunctionViewInformationList ToNative(const JunctionViewInformationList proto);
+JunctionViewInformationList ToNative(const JunctionViewInformationList& proto);
+void ToNative(const JunctionViewInformationList& proto, JunctionViewInformationList* out);
+JunctionViewInformationList ToNative(JunctionViewInformationList&& proto);
+void ToNative(JunctionViewInformationList&& proto, JunctionViewInformationList* out);
 JunctionViewInformationList ToProto(const JunctionViewInformationList& native);
+void ToProto(const JunctionViewInformationList& native, JunctionViewInformationList* out);
 
 // Conversion functions for JunctionViewInformation
-JunctionViewInformation ToNative(const JunctionViewInformation proto);
+JunctionViewInformation ToNative(const JunctionViewInformation& proto);
+void ToNative(const JunctionViewInformation& proto, JunctionViewInformation* out);
+JunctionViewInformation ToNative(JunctionViewInformation&& proto);
+void ToNative(JunctionViewInformation&& proto, JunctionViewInformation* out);
 JunctionViewInformation ToProto(const JunctionViewInformation& native);
+void ToProto(const JunctionViewInformation& native, JunctionViewInformation* out);
 
 // Conversion functions for JunctionViewError
-JunctionViewError ToNative(const JunctionViewError proto);
+JunctionViewError ToNative(const JunctionViewError& proto);
+void ToNative(const JunctionViewError& proto, JunctionViewError* out);
+JunctionViewError ToNative(JunctionViewError&& proto);
+void ToNative(JunctionViewError&& proto, JunctionViewError* out);
 JunctionViewError ToProto(const JunctionViewError& native);
+void ToProto(const JunctionViewError& native, JunctionViewError* out);
 
 // Conversion functions for ErrorType
 ErrorType ToNative(const JunctionViewError_ErrorType proto);
 JunctionViewError_ErrorType ToProto(const ErrorType native);
 
 // Conversion functions for JunctionViewResult
-JunctionViewResult ToNative(const JunctionViewResult proto);
+JunctionViewResult ToNative(const JunctionViewResult& proto);
+void ToNative(const JunctionViewResult& proto, JunctionViewResult* out);
+JunctionViewResult ToNative(JunctionViewResult&& proto);
+void ToNative(JunctionViewResult&& proto, JunctionViewResult* out);
 JunctionViewResult ToProto(const JunctionViewResult& native);
+void ToProto(const JunctionViewResult& native, JunctionViewResult* out);
 
 }  // namespace protobuf_helpers
 
@@ -15,6 +15,7 @@
 #define PROTOBUF_HELPERS_HPP
 
 #include <string>
+#include <utility>
 #include <vector>
 
 // Forward declarations
@@ -103,56 +104,108 @@ ExitHovDirection ToNative(const ExitHovDirection proto);
 ExitHovDirection ToProto(const ExitHovDirection native);
 
 // Conversion functions for RoadIdentifier
-RoadIdentifier ToNative(const RoadIdentifier proto);
+RoadIdentifier ToNative(const RoadIdentifier& proto);
+void ToNative(const RoadIdentifier& proto, RoadIdentifier* out);
+RoadIdentifier ToNative(RoadIdentifier&& proto);
+void ToNative(RoadIdentifier&& proto, RoadIdentifier* out);
 RoadIdentifier ToProto(const RoadIdentifier& native);
+void ToProto(const RoadIdentifier& native, RoadIdentifier* out);
 
 // Conversion functions for RoadInformation
-RoadInformation ToNative(const RoadInformation proto);
+RoadInformation ToNative(const RoadInformation& proto);
+void ToNative(const RoadInformation& proto, RoadInformation* out);
+RoadInformation ToNative(RoadInformation&& proto);
+void ToNative(RoadInformation&& proto, RoadInformation* out);
 RoadInformation ToProto(const RoadInformation& native);
+void ToProto(const RoadInformation& native, RoadInformation* out);
 
 // Conversion functions for Roundabout
-Roundabout ToNative(const Roundabout proto);
+Roundabout ToNative(const Roundabout& proto);
+void ToNative(const Roundabout& proto, Roundabout* out);
+Roundabout ToNative(Roundabout&& proto);
+void ToNative(Roundabout&& proto, Roundabout* out);
 Roundabout ToProto(const Roundabout& native);
+void ToProto(const Roundabout& native, Roundabout* out);
 
 // Conversion functions for ExitRoundabout
-ExitRoundabout ToNative(const ExitRoundabout proto);
+ExitRoundabout ToNative(const ExitRoundabout& proto);
+void ToNative(const ExitRoundabout& proto, ExitRoundabout* out);
+ExitRoundabout ToNative(ExitRoundabout&& proto);
+void ToNative(ExitRoundabout&& proto, ExitRoundabout* out);
 ExitRoundabout ToProto(const ExitRoundabout& native);
+void ToProto(const ExitRoundabout& native, ExitRoundabout* out);
 
 // Conversion functions for Signpost
-Signpost ToNative(const Signpost proto);
+Signpost ToNative(const Signpost& proto);
+void ToNative(const Signpost& proto, Signpost* out);
+Signpost ToNative(Signpost&& proto);
+void ToNative(Signpost&& proto, Signpost* out);
 Signpost ToProto(const Signpost& native);
+void ToProto(const Signpost& native, Signpost* out);
 
 // Conversion functions for TextWithPhonetic
-TextWithPhonetic ToNative(const TextWithPhonetic proto);
+TextWithPhonetic ToNative(const TextWithPhonetic& proto);
+void ToNative(const TextWithPhonetic& proto, TextWithPhonetic* out);
+TextWithPhonetic ToNative(TextWithPhonetic&& proto);
+void ToNative(TextWithPhonetic&& proto, TextWithPhonetic* out);
 TextWithPhonetic ToProto(const TextWithPhonetic& native);
+void ToProto(const TextWithPhonetic& native, TextWithPhonetic* out);
 
 // Conversion functions for PhoneticString
-PhoneticString ToNative(const PhoneticString proto);
+PhoneticString ToNative(const PhoneticString& proto);
+void ToNative(const PhoneticString& proto, PhoneticString* out);
+PhoneticString ToNative(PhoneticString&& proto);
+void ToNative(PhoneticString&& proto, PhoneticString* out);
 PhoneticString ToProto(const PhoneticString& native);
+void ToProto(const PhoneticString& native, PhoneticString* out);
 
 // Conversion functions for PhoneticStringWithPreposition
-PhoneticStringWithPreposition ToNative(const PhoneticStringWithPreposition proto);
+PhoneticStringWithPreposition ToNative(const PhoneticStringWithPreposition& proto);
+void ToNative(const PhoneticStringWithPreposition& proto, PhoneticStringWithPreposition* out);
+PhoneticStringWithPreposition ToNative(PhoneticStringWithPreposition&& proto);
+void ToNative(PhoneticStringWithPreposition&& proto, PhoneticStringWithPreposition* out);
 PhoneticStringWithPreposition ToProto(const PhoneticStringWithPreposition& native);
+void ToProto(const PhoneticStringWithPreposition& native, PhoneticStringWithPreposition* out);
 
 // Conversion functions for BorderCrossing
-BorderCrossing ToNative(const BorderCrossing proto);
+BorderCrossing ToNative(const BorderCrossing& proto);
+void ToNative(const BorderCrossing& proto, BorderCrossing* out);
+BorderCrossing ToNative(BorderCrossing&& proto);
+void ToNative(BorderCrossing&& proto, BorderCrossing* out);
 BorderCrossing ToProto(const BorderCrossing& native);
+void ToProto(const BorderCrossing& native, BorderCrossing* out);
 
 // Conversion functions for CountryInfo
-CountryInfo ToNative(const CountryInfo proto);
+CountryInfo ToNative(const CountryInfo& proto);
+void ToNative(const CountryInfo& proto, CountryInfo* out);
+CountryInfo ToNative(CountryInfo&& proto);
+void ToNative(CountryInfo&& proto, CountryInfo* out);
 CountryInfo ToProto(const CountryInfo& native);
+void ToProto(const CountryInfo& native, CountryInfo* out);
 
 // Conversion functions for ChargingStop
-ChargingStop ToNative(const ChargingStop proto);
+ChargingStop ToNative(const ChargingStop& proto);
+void ToNative(const ChargingStop& proto, ChargingStop* out);
+ChargingStop ToNative(ChargingStop&& proto);
+void ToNative(ChargingStop&& proto, ChargingStop* out);
 ChargingStop ToProto(const ChargingStop& native);
+void ToProto(const ChargingStop& native, ChargingStop* out);
 
 // Conversion functions for AudioInstruction
-AudioInstruction ToNative(const AudioInstruction proto);
+AudioInstruction ToNative(const AudioInstruction& proto);
+void ToNative(const AudioInstruction& proto, AudioInstruction* out);
+AudioInstruction ToNative(AudioInstruction&& proto);
+void ToNative(AudioInstruction&& proto, AudioInstruction* out);
 AudioInstruction ToProto(const AudioInstruction& native);
+void ToProto(const AudioInstruction& native, AudioInstruction* out);
 
 // Conversion functions for Lane
-Lane ToNative(const Lane proto);
+Lane ToNative(const Lane& proto);
+void ToNative(const Lane& proto, Lane* out);
+Lane ToNative(Lane&& proto);
+void ToNative(Lane&& proto, Lane* out);
 Lane ToProto(const Lane& native);
+void ToProto(const Lane& native, Lane* out);
 
 // Conversion functions for LaneDirection
 LaneDirection ToNative(const Lane_LaneDirection proto);
@@ -15,20 +15,41 @@
 
 namespace protobuf_helpers {
 
-Language ToNative(const Language proto) {
+Language ToNative(const Language& proto) {
     Language result;
-    result.isoLanguageCode = proto.iso_language_code();
-    result.isoCountryCode = proto.iso_country_code();
-    result.isoScriptCode = proto.iso_script_code();
+    ToNative(proto, &result);
     return result;
 }
 
+void ToNative(const Language& proto, Language* out) {
+    out->isoLanguageCode = proto.iso_language_code();
+    out->isoCountryCode = proto.iso_country_code();
+    out->isoScriptCode = proto.iso_script_code();
+}
+
+Language ToNative(Language&& proto) {
+    Language result;
+    ToNative(std::move(proto), &result);
+    return result;
+}
+
+void ToNative(Language&& proto, Language* out) {
+    out->isoLanguageCode = std::move(*proto.mutable_iso_language_code());
+    out->isoCountryCode = std::move(*proto.mutable_iso_country_code());
+    out->isoScriptCode = std::move(*proto.mutable_iso_script_code());
+}
+
 Language ToProto(const Language& native) {
     Language result;
-    result.set_iso_language_code(native.isoLanguageCode);
-    result.set_iso_country_code(native.isoCountryCode);
-    result.set_iso_script_code(native.isoScriptCode);
+    ToProto(native, &result);
     return result;
 }
 
+void ToProto(const Language& native, Language* out) {
+    out->Clear();
+    out->set_iso_language_code(native.isoLanguageCode);
+    out->set_iso_country_code(native.isoCountryCode);
+    out->set_iso_script_code(native.isoScriptCode);
+}
+
 }  // namespace protobuf_helpers
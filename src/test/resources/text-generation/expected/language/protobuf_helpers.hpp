@@ -15,6 +15,7 @@
 #define PROTOBUF_HELPERS_HPP
 
 #include <string>
+#include <utility>
 #include <vector>
 
 // Forward declarations
@@ -23,8 +24,12 @@ struct Language;
 namespace protobuf_helpers {
 
 // Conversion functions for Language
-Language ToNative(const Language proto);
+Language ToNative(const Language& proto);
+void ToNative(const Language& proto, Language* out);
+Language ToNative(Language&& proto);
+void ToNative(Language&& proto, Language* out);
 Language ToProto(const Language& native);
+void ToProto(const Language& native, Language* out);
 
 }  // namespace protobuf_helpers
 
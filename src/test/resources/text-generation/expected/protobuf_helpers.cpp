@@ -389,258 +389,564 @@ ExitHovDirection ToProto(const ExitHovDirection native) {
     }
 }
 
-RoadIdentifier ToNative(const RoadIdentifier proto) {
+RoadIdentifier ToNative(const RoadIdentifier& proto) {
     RoadIdentifier result;
-    result.identifier = ToNative(proto.identifier());
-    result.source = ToNative(proto.source());
-    result.roadAttribute = ToNative(proto.road_attribute());
+    ToNative(proto, &result);
     return result;
 }
 
+void ToNative(const RoadIdentifier& proto, RoadIdentifier* out) {
+    ToNative(proto.identifier(), &out->identifier);
+    out->source = ToNative(proto.source());
+    out->roadAttribute = ToNative(proto.road_attribute());
+}
+
+RoadIdentifier ToNative(RoadIdentifier&& proto) {
+    RoadIdentifier result;
+    ToNative(std::move(proto), &result);
+    return result;
+}
+
+void ToNative(RoadIdentifier&& proto, RoadIdentifier* out) {
+    if (proto.has_identifier()) { ToNative(std::move(*proto.mutable_identifier()), &out->identifier); } else { ToNative(proto.identifier(), &out->identifier); }
+    out->source = ToNative(proto.source());
+    out->roadAttribute = ToNative(proto.road_attribute());
+}
+
 RoadIdentifier ToProto(const RoadIdentifier& native) {
     RoadIdentifier result;
-    result.mutable_identifier()->CopyFrom(ToProto(native.identifier));
-    result.set_source(ToProto(native.source));
-    result.set_road_attribute(ToProto(native.roadAttribute));
+    ToProto(native, &result);
     return result;
 }
 
-RoadInformation ToNative(const RoadInformation proto) {
+void ToProto(const RoadIdentifier& native, RoadIdentifier* out) {
+    out->Clear();
+    ToProto(native.identifier, out->mutable_identifier());
+    out->set_source(ToProto(native.source));
+    out->set_road_attribute(ToProto(native.roadAttribute));
+}
+
+RoadInformation ToNative(const RoadInformation& proto) {
+    RoadInformation result;
+    ToNative(proto, &result);
+    return result;
+}
+
+void ToNative(const RoadInformation& proto, RoadInformation* out) {
+    out->roadNames.resize(proto.road_names_size());
+    for (int i = 0; i < proto.road_names_size(); ++i) { ToNative(proto.road_names(i), &out->roadNames[i]); }
+    out->roadNumbers.resize(proto.road_numbers_size());
+    for (int i = 0; i < proto.road_numbers_size(); ++i) { ToNative(proto.road_numbers(i), &out->roadNumbers[i]); }
+    out->isUrbanArea = proto.is_urban_area();
+    out->isControlledAccess = proto.is_controlled_access();
+    out->isMotorway = proto.is_motorway();
+    out->countryCode = proto.country_code();
+}
+
+RoadInformation ToNative(RoadInformation&& proto) {
     RoadInformation result;
-    for (const auto& item : proto.road_names()) { result.roadNames.push_back(ToNative(item)); }
-    for (const auto& item : proto.road_numbers()) { result.roadNumbers.push_back(ToNative(item)); }
-    result.isUrbanArea = proto.is_urban_area();
-    result.isControlledAccess = proto.is_controlled_access();
-    result.isMotorway = proto.is_motorway();
-    result.countryCode = proto.country_code();
+    ToNative(std::move(proto), &result);
     return result;
 }
 
+void ToNative(RoadInformation&& proto, RoadInformation* out) {
+    out->roadNames.resize(proto.road_names_size());
+    for (int i = 0; i < proto.road_names_size(); ++i) { ToNative(std::move(*proto.mutable_road_names(i)), &out->roadNames[i]); }
+    out->roadNumbers.resize(proto.road_numbers_size());
+    for (int i = 0; i < proto.road_numbers_size(); ++i) { ToNative(std::move(*proto.mutable_road_numbers(i)), &out->roadNumbers[i]); }
+    out->isUrbanArea = proto.is_urban_area();
+    out->isControlledAccess = proto.is_controlled_access();
+    out->isMotorway = proto.is_motorway();
+    out->countryCode = std::move(*proto.mutable_country_code());
+}
+
 RoadInformation ToProto(const RoadInformation& native) {
     RoadInformation result;
+    ToProto(native, &result);
+    return result;
+}
+
+void ToProto(const RoadInformation& native, RoadInformation* out) {
+    out->Clear();
+    out->mutable_road_names()->Reserve(static_cast<int>(native.roadNames.size()));
     for (const auto& item : native.roadNames) {
-        result.add_road_names(item);
+        ToProto(item, out->add_road_names());
     }
+    out->mutable_road_numbers()->Reserve(static_cast<int>(native.roadNumbers.size()));
     for (const auto& item : native.roadNumbers) {
-        result.add_road_numbers(item);
+        ToProto(item, out->add_road_numbers());
     }
-    result.set_is_urban_area(native.isUrbanArea);
-    result.set_is_controlled_access(native.isControlledAccess);
-    result.set_is_motorway(native.isMotorway);
-    result.set_country_code(native.countryCode);
+    out->set_is_urban_area(native.isUrbanArea);
+    out->set_is_controlled_access(native.isControlledAccess);
+    out->set_is_motorway(native.isMotorway);
+    out->set_country_code(native.countryCode);
+}
+
+Roundabout ToNative(const Roundabout& proto) {
+    Roundabout result;
+    ToNative(proto, &result);
     return result;
 }
 
-Roundabout ToNative(const Roundabout proto) {
+void ToNative(const Roundabout& proto, Roundabout* out) {
+    out->direction = ToNative(proto.direction());
+    out->angleInDegrees = proto.angle_in_degrees();
+    out->turnAngle = ToNative(proto.turn_angle());
+    out->exitNumber = proto.exit_number();
+    out->roundaboutType = ToNative(proto.roundabout_type());
+}
+
+Roundabout ToNative(Roundabout&& proto) {
     Roundabout result;
-    result.direction = ToNative(proto.direction());
-    result.angleInDegrees = proto.angle_in_degrees();
-    result.turnAngle = ToNative(proto.turn_angle());
-    result.exitNumber = proto.exit_number();
-    result.roundaboutType = ToNative(proto.roundabout_type());
+    ToNative(std::move(proto), &result);
     return result;
 }
 
+void ToNative(Roundabout&& proto, Roundabout* out) {
+    out->direction = ToNative(proto.direction());
+    out->angleInDegrees = proto.angle_in_degrees();
+    out->turnAngle = ToNative(proto.turn_angle());
+    out->exitNumber = proto.exit_number();
+    out->roundaboutType = ToNative(proto.roundabout_type());
+}
+
 Roundabout ToProto(const Roundabout& native) {
     Roundabout result;
-    result.set_direction(ToProto(native.direction));
-    result.set_angle_in_degrees(native.angleInDegrees);
-    result.set_turn_angle(ToProto(native.turnAngle));
-    result.set_exit_number(native.exitNumber);
-    result.set_roundabout_type(ToProto(native.roundaboutType));
+    ToProto(native, &result);
     return result;
 }
 
-ExitRoundabout ToNative(const ExitRoundabout proto) {
+void ToProto(const Roundabout& native, Roundabout* out) {
+    out->Clear();
+    out->set_direction(ToProto(native.direction));
+    out->set_angle_in_degrees(native.angleInDegrees);
+    out->set_turn_angle(ToProto(native.turnAngle));
+    out->set_exit_number(native.exitNumber);
+    out->set_roundabout_type(ToProto(native.roundaboutType));
+}
+
+ExitRoundabout ToNative(const ExitRoundabout& proto) {
     ExitRoundabout result;
-    result.roundabout = ToNative(proto.roundabout());
+    ToNative(proto, &result);
     return result;
 }
 
+void ToNative(const ExitRoundabout& proto, ExitRoundabout* out) {
+    ToNative(proto.roundabout(), &out->roundabout);
+}
+
+ExitRoundabout ToNative(ExitRoundabout&& proto) {
+    ExitRoundabout result;
+    ToNative(std::move(proto), &result);
+    return result;
+}
+
+void ToNative(ExitRoundabout&& proto, ExitRoundabout* out) {
+    if (proto.has_roundabout()) { ToNative(std::move(*proto.mutable_roundabout()), &out->roundabout); } else { ToNative(proto.roundabout(), &out->roundabout); }
+}
+
 ExitRoundabout ToProto(const ExitRoundabout& native) {
     ExitRoundabout result;
-    result.mutable_roundabout()->CopyFrom(ToProto(native.roundabout));
+    ToProto(native, &result);
+    return result;
+}
+
+void ToProto(const ExitRoundabout& native, ExitRoundabout* out) {
+    out->Clear();
+    ToProto(native.roundabout, out->mutable_roundabout());
+}
+
+Signpost ToNative(const Signpost& proto) {
+    Signpost result;
+    ToNative(proto, &result);
     return result;
 }
 
-Signpost ToNative(const Signpost proto) {
+void ToNative(const Signpost& proto, Signpost* out) {
+    ToNative(proto.exit_number(), &out->exitNumber);
+    ToNative(proto.exit_name(), &out->exitName);
+    ToNative(proto.toward_name(), &out->towardName);
+}
+
+Signpost ToNative(Signpost&& proto) {
     Signpost result;
-    result.exitNumber = ToNative(proto.exit_number());
-    result.exitName = ToNative(proto.exit_name());
-    result.towardName = ToNative(proto.toward_name());
+    ToNative(std::move(proto), &result);
     return result;
 }
 
+void ToNative(Signpost&& proto, Signpost* out) {
+    if (proto.has_exit_number()) { ToNative(std::move(*proto.mutable_exit_number()), &out->exitNumber); } else { ToNative(proto.exit_number(), &out->exitNumber); }
+    if (proto.has_exit_name()) { ToNative(std::move(*proto.mutable_exit_name()), &out->exitName); } else { ToNative(proto.exit_name(), &out->exitName); }
+    if (proto.has_toward_name()) { ToNative(std::move(*proto.mutable_toward_name()), &out->towardName); } else { ToNative(proto.toward_name(), &out->towardName); }
+}
+
 Signpost ToProto(const Signpost& native) {
     Signpost result;
-    result.mutable_exit_number()->CopyFrom(ToProto(native.exitNumber));
-    result.mutable_exit_name()->CopyFrom(ToProto(native.exitName));
-    result.mutable_toward_name()->CopyFrom(ToProto(native.towardName));
+    ToProto(native, &result);
+    return result;
+}
+
+void ToProto(const Signpost& native, Signpost* out) {
+    out->Clear();
+    ToProto(native.exitNumber, out->mutable_exit_number());
+    ToProto(native.exitName, out->mutable_exit_name());
+    ToProto(native.towardName, out->mutable_toward_name());
+}
+
+TextWithPhonetic ToNative(const TextWithPhonetic& proto) {
+    TextWithPhonetic result;
+    ToNative(proto, &result);
     return result;
 }
 
-TextWithPhonetic ToNative(const TextWithPhonetic proto) {
+void ToNative(const TextWithPhonetic& proto, TextWithPhonetic* out) {
+    out->text = proto.text();
+    ToNative(proto.text_language(), &out->textLanguage);
+    ToNative(proto.generic_use_case_phonetic_string(), &out->genericUseCasePhoneticString);
+    ToNative(proto.into_use_case_phonetic_string(), &out->intoUseCasePhoneticString);
+    ToNative(proto.follow_use_case_phonetic_string(), &out->followUseCasePhoneticString);
+}
+
+TextWithPhonetic ToNative(TextWithPhonetic&& proto) {
     TextWithPhonetic result;
-    result.text = proto.text();
-    result.textLanguage = ToNative(proto.text_language());
-    result.genericUseCasePhoneticString = ToNative(proto.generic_use_case_phonetic_string());
-    result.intoUseCasePhoneticString = ToNative(proto.into_use_case_phonetic_string());
-    result.followUseCasePhoneticString = ToNative(proto.follow_use_case_phonetic_string());
+    ToNative(std::move(proto), &result);
     return result;
 }
 
+void ToNative(TextWithPhonetic&& proto, TextWithPhonetic* out) {
+    out->text = std::move(*proto.mutable_text());
+    if (proto.has_text_language()) { ToNative(std::move(*proto.mutable_text_language()), &out->textLanguage); } else { ToNative(proto.text_language(), &out->textLanguage); }
+    if (proto.has_generic_use_case_phonetic_string()) { ToNative(std::move(*proto.mutable_generic_use_case_phonetic_string()), &out->genericUseCasePhoneticString); } else { ToNative(proto.generic_use_case_phonetic_string(), &out->genericUseCasePhoneticString); }
+    if (proto.has_into_use_case_phonetic_string()) { ToNative(std::move(*proto.mutable_into_use_case_phonetic_string()), &out->intoUseCasePhoneticString); } else { ToNative(proto.into_use_case_phonetic_string(), &out->intoUseCasePhoneticString); }
+    if (proto.has_follow_use_case_phonetic_string()) { ToNative(std::move(*proto.mutable_follow_use_case_phonetic_string()), &out->followUseCasePhoneticString); } else { ToNative(proto.follow_use_case_phonetic_string(), &out->followUseCasePhoneticString); }
+}
+
 TextWithPhonetic ToProto(const TextWithPhonetic& native) {
     TextWithPhonetic result;
-    result.set_text(native.text);
-    result.mutable_text_language()->CopyFrom(ToProto(native.textLanguage));
-    result.mutable_generic_use_case_phonetic_string()->CopyFrom(ToProto(native.genericUseCasePhoneticString));
-    result.mutable_into_use_case_phonetic_string()->CopyFrom(ToProto(native.intoUseCasePhoneticString));
-    result.mutable_follow_use_case_phonetic_string()->CopyFrom(ToProto(native.followUseCasePhoneticString));
+    ToProto(native, &result);
+    return result;
+}
+
+void ToProto(const TextWithPhonetic& native, TextWithPhonetic* out) {
+    out->Clear();
+    out->set_text(native.text);
+    ToProto(native.textLanguage, out->mutable_text_language());
+    ToProto(native.genericUseCasePhoneticString, out->mutable_generic_use_case_phonetic_string());
+    ToProto(native.intoUseCasePhoneticString, out->mutable_into_use_case_phonetic_string());
+    ToProto(native.followUseCasePhoneticString, out->mutable_follow_use_case_phonetic_string());
+}
+
+PhoneticString ToNative(const PhoneticString& proto) {
+    PhoneticString result;
+    ToNative(proto, &result);
     return result;
 }
 
-PhoneticString ToNative(const PhoneticString proto) {
+void ToNative(const PhoneticString& proto, PhoneticString* out) {
+    out->value = proto.value();
+    out->alphabet = proto.alphabet();
+    ToNative(proto.language(), &out->language);
+}
+
+PhoneticString ToNative(PhoneticString&& proto) {
     PhoneticString result;
-    result.value = proto.value();
-    result.alphabet = proto.alphabet();
-    result.language = ToNative(proto.language());
+    ToNative(std::move(proto), &result);
     return result;
 }
 
+void ToNative(PhoneticString&& proto, PhoneticString* out) {
+    out->value = std::move(*proto.mutable_value());
+    out->alphabet = std::move(*proto.mutable_alphabet());
+    if (proto.has_language()) { ToNative(std::move(*proto.mutable_language()), &out->language); } else { ToNative(proto.language(), &out->language); }
+}
+
 PhoneticString ToProto(const PhoneticString& native) {
     PhoneticString result;
-    result.set_value(native.value);
-    result.set_alphabet(native.alphabet);
-    result.mutable_language()->CopyFrom(ToProto(native.language));
+    ToProto(native, &result);
     return result;
 }
 
-PhoneticStringWithPreposition ToNative(const PhoneticStringWithPreposition proto) {
+void ToProto(const PhoneticString& native, PhoneticString* out) {
+    out->Clear();
+    out->set_value(native.value);
+    out->set_alphabet(native.alphabet);
+    ToProto(native.language, out->mutable_language());
+}
+
+PhoneticStringWithPreposition ToNative(const PhoneticStringWithPreposition& proto) {
     PhoneticStringWithPreposition result;
-    result.phoneticString = ToNative(proto.phonetic_string());
-    result.prefix = proto.prefix();
+    ToNative(proto, &result);
     return result;
 }
 
+void ToNative(const PhoneticStringWithPreposition& proto, PhoneticStringWithPreposition* out) {
+    ToNative(proto.phonetic_string(), &out->phoneticString);
+    out->prefix = proto.prefix();
+}
+
+PhoneticStringWithPreposition ToNative(PhoneticStringWithPreposition&& proto) {
+    PhoneticStringWithPreposition result;
+    ToNative(std::move(proto), &result);
+    return result;
+}
+
+void ToNative(PhoneticStringWithPreposition&& proto, PhoneticStringWithPreposition* out) {
+    if (proto.has_phonetic_string()) { ToNative(std::move(*proto.mutable_phonetic_string()), &out->phoneticString); } else { ToNative(proto.phonetic_string(), &out->phoneticString); }
+    out->prefix = std::move(*proto.mutable_prefix());
+}
+
 PhoneticStringWithPreposition ToProto(const PhoneticStringWithPreposition& native) {
     PhoneticStringWithPreposition result;
-    result.mutable_phonetic_string()->CopyFrom(ToProto(native.phoneticString));
-    result.set_prefix(native.prefix);
+    ToProto(native, &result);
     return result;
 }
 
-BorderCrossing ToNative(const BorderCrossing proto) {
+void ToProto(const PhoneticStringWithPreposition& native, PhoneticStringWithPreposition* out) {
+    out->Clear();
+    ToProto(native.phoneticString, out->mutable_phonetic_string());
+    out->set_prefix(native.prefix);
+}
+
+BorderCrossing ToNative(const BorderCrossing& proto) {
     BorderCrossing result;
-    result.fromCountry = ToNative(proto.from_country());
-    result.toCountry = ToNative(proto.to_country());
+    ToNative(proto, &result);
     return result;
 }
 
+void ToNative(const BorderCrossing& proto, BorderCrossing* out) {
+    ToNative(proto.from_country(), &out->fromCountry);
+    ToNative(proto.to_country(), &out->toCountry);
+}
+
+BorderCrossing ToNative(BorderCrossing&& proto) {
+    BorderCrossing result;
+    ToNative(std::move(proto), &result);
+    return result;
+}
+
+void ToNative(BorderCrossing&& proto, BorderCrossing* out) {
+    if (proto.has_from_country()) { ToNative(std::move(*proto.mutable_from_country()), &out->fromCountry); } else { ToNative(proto.from_country(), &out->fromCountry); }
+    if (proto.has_to_country()) { ToNative(std::move(*proto.mutable_to_country()), &out->toCountry); } else { ToNative(proto.to_country(), &out->toCountry); }
+}
+
 BorderCrossing ToProto(const BorderCrossing& native) {
     BorderCrossing result;
-    result.mutable_from_country()->CopyFrom(ToProto(native.fromCountry));
-    result.mutable_to_country()->CopyFrom(ToProto(native.toCountry));
+    ToProto(native, &result);
+    return result;
+}
+
+void ToProto(const BorderCrossing& native, BorderCrossing* out) {
+    out->Clear();
+    ToProto(native.fromCountry, out->mutable_from_country());
+    ToProto(native.toCountry, out->mutable_to_country());
+}
+
+CountryInfo ToNative(const CountryInfo& proto) {
+    CountryInfo result;
+    ToNative(proto, &result);
     return result;
 }
 
-CountryInfo ToNative(const CountryInfo proto) {
+void ToNative(const CountryInfo& proto, CountryInfo* out) {
+    ToNative(proto.country_name(), &out->countryName);
+    out->isoCountryCode = proto.iso_country_code();
+}
+
+CountryInfo ToNative(CountryInfo&& proto) {
     CountryInfo result;
-    result.countryName = ToNative(proto.country_name());
-    result.isoCountryCode = proto.iso_country_code();
+    ToNative(std::move(proto), &result);
     return result;
 }
 
+void ToNative(CountryInfo&& proto, CountryInfo* out) {
+    if (proto.has_country_name()) { ToNative(std::move(*proto.mutable_country_name()), &out->countryName); } else { ToNative(proto.country_name(), &out->countryName); }
+    out->isoCountryCode = std::move(*proto.mutable_iso_country_code());
+}
+
 CountryInfo ToProto(const CountryInfo& native) {
     CountryInfo result;
-    result.mutable_country_name()->CopyFrom(ToProto(native.countryName));
-    result.set_iso_country_code(native.isoCountryCode);
+    ToProto(native, &result);
     return result;
 }
 
-ChargingStop ToNative(const ChargingStop proto) {
+void ToProto(const CountryInfo& native, CountryInfo* out) {
+    out->Clear();
+    ToProto(native.countryName, out->mutable_country_name());
+    out->set_iso_country_code(native.isoCountryCode);
+}
+
+ChargingStop ToNative(const ChargingStop& proto) {
+    ChargingStop result;
+    ToNative(proto, &result);
+    return result;
+}
+
+void ToNative(const ChargingStop& proto, ChargingStop* out) {
+    ToNative(proto.operator_name(), &out->operatorName);
+}
+
+ChargingStop ToNative(ChargingStop&& proto) {
     ChargingStop result;
-    result.operatorName = ToNative(proto.operator_name());
+    ToNative(std::move(proto), &result);
     return result;
 }
 
+void ToNative(ChargingStop&& proto, ChargingStop* out) {
+    if (proto.has_operator_name()) { ToNative(std::move(*proto.mutable_operator_name()), &out->operatorName); } else { ToNative(proto.operator_name(), &out->operatorName); }
+}
+
 ChargingStop ToProto(const ChargingStop& native) {
     ChargingStop result;
-    result.mutable_operator_name()->CopyFrom(ToProto(native.operatorName));
+    ToProto(native, &result);
+    return result;
+}
+
+void ToProto(const ChargingStop& native, ChargingStop* out) {
+    out->Clear();
+    ToProto(native.operatorName, out->mutable_operator_name());
+}
+
+AudioInstruction ToNative(const AudioInstruction& proto) {
+    AudioInstruction result;
+    ToNative(proto, &result);
     return result;
 }
 
-AudioInstruction ToNative(const AudioInstruction proto) {
+void ToNative(const AudioInstruction& proto, AudioInstruction* out) {
+    out->type = ToNative(proto.type());
+    out->drivingSide = ToNative(proto.driving_side());
+    out->itineraryPointSide = ToNative(proto.itinerary_point_side());
+    ToNative(proto.incoming_road_information(), &out->incomingRoadInformation);
+    ToNative(proto.outgoing_road_information(), &out->outgoingRoadInformation);
+    out->landmark = ToNative(proto.landmark());
+    ToNative(proto.signpost(), &out->signpost);
+    if (proto.has_traffic_light_offset_in_centimeters()) { out->trafficLightOffsetInCentimeters = proto.traffic_light_offset_in_centimeters(); } else { out->trafficLightOffsetInCentimeters.reset(); }
+    out->exitDirection = ToNative(proto.exit_direction());
+    if (proto.has_side_street_offset_in_centimeters()) { out->sideStreetOffsetInCentimeters = proto.side_street_offset_in_centimeters(); } else { out->sideStreetOffsetInCentimeters.reset(); }
+    out->forkDirection = ToNative(proto.fork_direction());
+    ToNative(proto.intersection_name_with_phonetic(), &out->intersectionNameWithPhonetic);
+    out->turnDirection = ToNative(proto.turn_direction());
+    out->switchHighwayDirection = ToNative(proto.switch_highway_direction());
+    out->enterHovDirection = ToNative(proto.enter_hov_direction());
+    out->exitHovDirection = ToNative(proto.exit_hov_direction());
+    out->mergeSide = ToNative(proto.merge_side());
+    ToNative(proto.roundabout(), &out->roundabout);
+    ToNative(proto.exit_roundabout(), &out->exitRoundabout);
+    ToNative(proto.border_crossing(), &out->borderCrossing);
+    out->autoTransportType = ToNative(proto.auto_transport_type());
+    out->laneGuidance.resize(proto.lane_guidance_size());
+    for (int i = 0; i < proto.lane_guidance_size(); ++i) { ToNative(proto.lane_guidance(i), &out->laneGuidance[i]); }
+    ToNative(proto.charging_stop(), &out->chargingStop);
+}
+
+AudioInstruction ToNative(AudioInstruction&& proto) {
     AudioInstruction result;
-    result.type = ToNative(proto.type());
-    result.drivingSide = ToNative(proto.driving_side());
-    result.itineraryPointSide = ToNative(proto.itinerary_point_side());
-    result.incomingRoadInformation = ToNative(proto.incoming_road_information());
-    result.outgoingRoadInformation = ToNative(proto.outgoing_road_information());
-    result.landmark = ToNative(proto.landmark());
-    result.signpost = ToNative(proto.signpost());
-    if (proto.has_traffic_light_offset_in_centimeters()) { result.trafficLightOffsetInCentimeters = proto.traffic_light_offset_in_centimeters(); }
-    result.exitDirection = ToNative(proto.exit_direction());
-    if (proto.has_side_street_offset_in_centimeters()) { result.sideStreetOffsetInCentimeters = proto.side_street_offset_in_centimeters(); }
-    result.forkDirection = ToNative(proto.fork_direction());
-    result.intersectionNameWithPhonetic = ToNative(proto.intersection_name_with_phonetic());
-    result.turnDirection = ToNative(proto.turn_direction());
-    result.switchHighwayDirection = ToNative(proto.switch_highway_direction());
-    result.enterHovDirection = ToNative(proto.enter_hov_direction());
-    result.exitHovDirection = ToNative(proto.exit_hov_direction());
-    result.mergeSide = ToNative(proto.merge_side());
-    result.roundabout = ToNative(proto.roundabout());
-    result.exitRoundabout = ToNative(proto.exit_roundabout());
-    result.borderCrossing = ToNative(proto.border_crossing());
-    result.autoTransportType = ToNative(proto.auto_transport_type());
-    for (const auto& item : proto.lane_guidance()) { result.laneGuidance.push_back(ToNative(item)); }
-    result.chargingStop = ToNative(proto.charging_stop());
+    ToNative(std::move(proto), &result);
     return result;
 }
 
+void ToNative(AudioInstruction&& proto, AudioInstruction* out) {
+    out->type = ToNative(proto.type());
+    out->drivingSide = ToNative(proto.driving_side());
+    out->itineraryPointSide = ToNative(proto.itinerary_point_side());
+    if (proto.has_incoming_road_information()) { ToNative(std::move(*proto.mutable_incoming_road_information()), &out->incomingRoadInformation); } else { ToNative(proto.incoming_road_information(), &out->incomingRoadInformation); }
+    if (proto.has_outgoing_road_information()) { ToNative(std::move(*proto.mutable_outgoing_road_information()), &out->outgoingRoadInformation); } else { ToNative(proto.outgoing_road_information(), &out->outgoingRoadInformation); }
+    out->landmark = ToNative(proto.landmark());
+    if (proto.has_signpost()) { ToNative(std::move(*proto.mutable_signpost()), &out->signpost); } else { ToNative(proto.signpost(), &out->signpost); }
+    if (proto.has_traffic_light_offset_in_centimeters()) { out->trafficLightOffsetInCentimeters = proto.traffic_light_offset_in_centimeters(); } else { out->trafficLightOffsetInCentimeters.reset(); }
+    out->exitDirection = ToNative(proto.exit_direction());
+    if (proto.has_side_street_offset_in_centimeters()) { out->sideStreetOffsetInCentimeters = proto.side_street_offset_in_centimeters(); } else { out->sideStreetOffsetInCentimeters.reset(); }
+    out->forkDirection = ToNative(proto.fork_direction());
+    if (proto.has_intersection_name_with_phonetic()) { ToNative(std::move(*proto.mutable_intersection_name_with_phonetic()), &out->intersectionNameWithPhonetic); } else { ToNative(proto.intersection_name_with_phonetic(), &out->intersectionNameWithPhonetic); }
+    out->turnDirection = ToNative(proto.turn_direction());
+    out->switchHighwayDirection = ToNative(proto.switch_highway_direction());
+    out->enterHovDirection = ToNative(proto.enter_hov_direction());
+    out->exitHovDirection = ToNative(proto.exit_hov_direction());
+    out->mergeSide = ToNative(proto.merge_side());
+    if (proto.has_roundabout()) { ToNative(std::move(*proto.mutable_roundabout()), &out->roundabout); } else { ToNative(proto.roundabout(), &out->roundabout); }
+    if (proto.has_exit_roundabout()) { ToNative(std::move(*proto.mutable_exit_roundabout()), &out->exitRoundabout); } else { ToNative(proto.exit_roundabout(), &out->exitRoundabout); }
+    if (proto.has_border_crossing()) { ToNative(std::move(*proto.mutable_border_crossing()), &out->borderCrossing); } else { ToNative(proto.border_crossing(), &out->borderCrossing); }
+    out->autoTransportType = ToNative(proto.auto_transport_type());
+    out->laneGuidance.resize(proto.lane_guidance_size());
+    for (int i = 0; i < proto.lane_guidance_size(); ++i) { ToNative(std::move(*proto.mutable_lane_guidance(i)), &out->laneGuidance[i]); }
+    if (proto.has_charging_stop()) { ToNative(std::move(*proto.mutable_charging_stop()), &out->chargingStop); } else { ToNative(proto.charging_stop(), &out->chargingStop); }
+}
+
 AudioInstruction ToProto(const AudioInstruction& native) {
     AudioInstruction result;
-    result.set_type(ToProto(native.type));
-    result.set_driving_side(ToProto(native.drivingSide));
-    result.set_itinerary_point_side(ToProto(native.itineraryPointSide));
-    result.mutable_incoming_road_information()->CopyFrom(ToProto(native.incomingRoadInformation));
-    result.mutable_outgoing_road_information()->CopyFrom(ToProto(native.outgoingRoadInformation));
-    result.set_landmark(ToProto(native.landmark));
-    result.mutable_signpost()->CopyFrom(ToProto(native.signpost));
-    if (native.trafficLightOffsetInCentimeters.has_value()) { result.set_traffic_light_offset_in_centimeters(native.trafficLightOffsetInCentimeters.value()); }
-    result.set_exit_direction(ToProto(native.exitDirection));
-    if (native.sideStreetOffsetInCentimeters.has_value()) { result.set_side_street_offset_in_centimeters(native.sideStreetOffsetInCentimeters.value()); }
-    result.set_fork_direction(ToProto(native.forkDirection));
-    result.mutable_intersection_name_with_phonetic()->CopyFrom(ToProto(native.intersectionNameWithPhonetic));
-    result.set_turn_direction(ToProto(native.turnDirection));
-    result.set_switch_highway_direction(ToProto(native.switchHighwayDirection));
-    result.set_enter_hov_direction(ToProto(native.enterHovDirection));
-    result.set_exit_hov_direction(ToProto(native.exitHovDirection));
-    result.set_merge_side(ToProto(native.mergeSide));
-    result.mutable_roundabout()->CopyFrom(ToProto(native.roundabout));
-    result.mutable_exit_roundabout()->CopyFrom(ToProto(native.exitRoundabout));
-    result.mutable_border_crossing()->CopyFrom(ToProto(native.borderCrossing));
-    result.set_auto_transport_type(ToProto(native.autoTransportType));
+    ToProto(native, &result);
+    return result;
+}
+
+void ToProto(const AudioInstruction& native, AudioInstruction* out) {
+    out->Clear();
+    out->set_type(ToProto(native.type));
+    out->set_driving_side(ToProto(native.drivingSide));
+    out->set_itinerary_point_side(ToProto(native.itineraryPointSide));
+    ToProto(native.incomingRoadInformation, out->mutable_incoming_road_information());
+    ToProto(native.outgoingRoadInformation, out->mutable_outgoing_road_information());
+    out->set_landmark(ToProto(native.landmark));
+    ToProto(native.signpost, out->mutable_signpost());
+    if (native.trafficLightOffsetInCentimeters.has_value()) { out->set_traffic_light_offset_in_centimeters(native.trafficLightOffsetInCentimeters.value()); }
+    out->set_exit_direction(ToProto(native.exitDirection));
+    if (native.sideStreetOffsetInCentimeters.has_value()) { out->set_side_street_offset_in_centimeters(native.sideStreetOffsetInCentimeters.value()); }
+    out->set_fork_direction(ToProto(native.forkDirection));
+    ToProto(native.intersectionNameWithPhonetic, out->mutable_intersection_name_with_phonetic());
+    out->set_turn_direction(ToProto(native.turnDirection));
+    out->set_switch_highway_direction(ToProto(native.switchHighwayDirection));
+    out->set_enter_hov_direction(ToProto(native.enterHovDirection));
+    out->set_exit_hov_direction(ToProto(native.exitHovDirection));
+    out->set_merge_side(ToProto(native.mergeSide));
+    ToProto(native.roundabout, out->mutable_roundabout());
+    ToProto(native.exitRoundabout, out->mutable_exit_roundabout());
+    ToProto(native.borderCrossing, out->mutable_border_crossing());
+    out->set_auto_transport_type(ToProto(native.autoTransportType));
+    out->mutable_lane_guidance()->Reserve(static_cast<int>(native.laneGuidance.size()));
     for (const auto& item : native.laneGuidance) {
-        result.add_lane_guidance(item);
+        ToProto(item, out->add_lane_guidance());
     }
-    result.mutable_charging_stop()->CopyFrom(ToProto(native.chargingStop));
+    ToProto(native.chargingStop, out->mutable_charging_stop());
+}
+
+Lane ToNative(const Lane& proto) {
+    Lane result;
+    ToNative(proto, &result);
     return result;
 }
 
-Lane ToNative(const Lane proto) {
+void ToNative(const Lane& proto, Lane* out) {
+    out->directions.clear();
+    out->directions.reserve(proto.directions_size());
+    for (const auto& item : proto.directions()) { out->directions.push_back(ToNative(item)); }
+    out->followDirection = ToNative(proto.follow_direction());
+}
+
+Lane ToNative(Lane&& proto) {
     Lane result;
-    for (const auto& item : proto.directions()) { result.directions.push_back(ToNative(item)); }
-    result.followDirection = ToNative(proto.follow_direction());
+    ToNative(std::move(proto), &result);
     return result;
 }
 
+void ToNative(Lane&& proto, Lane* out) {
+    out->directions.clear();
+    out->directions.reserve(proto.directions_size());
+    for (const auto& item : proto.directions()) { out->directions.push_back(ToNative(item)); }
+    out->followDirection = ToNative(proto.follow_direction());
+}
+
 Lane ToProto(const Lane& native) {
     Lane result;
+    ToProto(native, &result);
+    return result;
+}
+
+void ToProto(const Lane& native, Lane* out) {
+    out->Clear();
+    out->mutable_directions()->Reserve(static_cast<int>(native.directions.size()));
     for (const auto& item : native.directions) {
-        result.add_directions(item);
+        out->add_directions(item);
     }
-    result.set_follow_direction(ToProto(native.followDirection));
-    return result;
+    out->set_follow_direction(ToProto(native.followDirection));
 }
 
 LaneDirection ToNative(const Lane_LaneDirection proto) {
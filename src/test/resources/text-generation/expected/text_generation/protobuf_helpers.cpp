@@ -15,38 +15,80 @@
 
 namespace protobuf_helpers {
 
-AudioMessage ToNative(const AudioMessage proto) {
+AudioMessage ToNative(const AudioMessage& proto) {
     AudioMessage result;
-    result.text = proto.text();
-    result.locale = proto.locale();
+    ToNative(proto, &result);
     return result;
 }
 
+void ToNative(const AudioMessage& proto, AudioMessage* out) {
+    out->text = proto.text();
+    out->locale = proto.locale();
+}
+
+AudioMessage ToNative(AudioMessage&& proto) {
+    AudioMessage result;
+    ToNative(std::move(proto), &result);
+    return result;
+}
+
+void ToNative(AudioMessage&& proto, AudioMessage* out) {
+    out->text = std::move(*proto.mutable_text());
+    out->locale = std::move(*proto.mutable_locale());
+}
+
 AudioMessage ToProto(const AudioMessage& native) {
     AudioMessage result;
-    result.set_text(native.text);
-    result.set_locale(native.locale);
+    ToProto(native, &result);
+    return result;
+}
+
+void ToProto(const AudioMessage& native, AudioMessage* out) {
+    out->Clear();
+    out->set_text(native.text);
+    out->set_locale(native.locale);
+}
+
+AnnouncementData ToNative(const AnnouncementData& proto) {
+    AnnouncementData result;
+    ToNative(proto, &result);
     return result;
 }
 
-AnnouncementData ToNative(const AnnouncementData proto) {
+void ToNative(const AnnouncementData& proto, AnnouncementData* out) {
+    out->distanceInCm = proto.distance_in_cm();
+    out->messageType = ToNative(proto.message_type());
+    ToNative(proto.instruction(), &out->instruction);
+    ToNative(proto.next_instruction(), &out->nextInstruction);
+}
+
+AnnouncementData ToNative(AnnouncementData&& proto) {
     AnnouncementData result;
-    result.distanceInCm = proto.distance_in_cm();
-    result.messageType = ToNative(proto.message_type());
-    result.instruction = ToNative(proto.instruction());
-    result.nextInstruction = ToNative(proto.next_instruction());
+    ToNative(std::move(proto), &result);
     return result;
 }
 
+void ToNative(AnnouncementData&& proto, AnnouncementData* out) {
+    out->distanceInCm = proto.distance_in_cm();
+    out->messageType = ToNative(proto.message_type());
+    if (proto.has_instruction()) { ToNative(std::move(*proto.mutable_instruction()), &out->instruction); } else { ToNative(proto.instruction(), &out->instruction); }
+    if (proto.has_next_instruction()) { ToNative(std::move(*proto.mutable_next_instruction()), &out->nextInstruction); } else { ToNative(proto.next_instruction(), &out->nextInstruction); }
+}
+
 AnnouncementData ToProto(const AnnouncementData& native) {
     AnnouncementData result;
-    result.set_distance_in_cm(native.distanceInCm);
-    result.set_message_type(ToProto(native.messageType));
-    result.mutable_instruction()->CopyFrom(ToProto(native.instruction));
-    result.mutable_next_instruction()->CopyFrom(ToProto(native.nextInstruction));
+    ToProto(native, &result);
     return result;
 }
 
+void ToProto(const AnnouncementData& native, AnnouncementData* out) {
+    out->Clear();
+    out->set_distance_in_cm(native.distanceInCm);
+    out->set_message_type(ToProto(native.messageType));
+    ToProto(native.instruction, out->mutable_instruction());
+    ToProto(native.nextInstruction, out->mutable_next_instruction());
+}
+
 MessageType ToNative(const AnnouncementData_MessageType proto) {
     switch (proto) {
         case AnnouncementData_MessageType::kFollow: return MessageType::KFOLLOW;
@@ -71,18 +113,37 @@ AnnouncementData_MessageType ToProto(const MessageType native) {
     }
 }
 
-VerbosityLevel ToNative(const VerbosityLevel proto) {
+VerbosityLevel ToNative(const VerbosityLevel& proto) {
     VerbosityLevel result;
-    result.level = ToNative(proto.level());
+    ToNative(proto, &result);
     return result;
 }
 
+void ToNative(const VerbosityLevel& proto, VerbosityLevel* out) {
+    out->level = ToNative(proto.level());
+}
+
+VerbosityLevel ToNative(VerbosityLevel&& proto) {
+    VerbosityLevel result;
+    ToNative(std::move(proto), &result);
+    return result;
+}
+
+void ToNative(VerbosityLevel&& proto, VerbosityLevel* out) {
+    out->level = ToNative(proto.level());
+}
+
 VerbosityLevel ToProto(const VerbosityLevel& native) {
     VerbosityLevel result;
-    result.set_level(ToProto(native.level));
+    ToProto(native, &result);
     return result;
 }
 
+void ToProto(const VerbosityLevel& native, VerbosityLevel* out) {
+    out->Clear();
+    out->set_level(ToProto(native.level));
+}
+
 Verbosity ToNative(const VerbosityLevel_Verbosity proto) {
     switch (proto) {
         case VerbosityLevel_Verbosity::kComprehensive: return Verbosity::KCOMPREHENSIVE;
@@ -99,18 +160,37 @@ VerbosityLevel_Verbosity ToProto(const Verbosity native) {
     }
 }
 
-UnitSystem ToNative(const UnitSystem proto) {
+UnitSystem ToNative(const UnitSystem& proto) {
+    UnitSystem result;
+    ToNative(proto, &result);
+    return result;
+}
+
+void ToNative(const UnitSystem& proto, UnitSystem* out) {
+    out->unitSystem = ToNative(proto.unit_system());
+}
+
+UnitSystem ToNative(UnitSystem&& proto) {
     UnitSystem result;
-    result.unitSystem = ToNative(proto.unit_system());
+    ToNative(std::move(proto), &result);
     return result;
 }
 
+void ToNative(UnitSystem&& proto, UnitSystem* out) {
+    out->unitSystem = ToNative(proto.unit_system());
+}
+
 UnitSystem ToProto(const UnitSystem& native) {
     UnitSystem result;
-    result.set_unit_system(ToProto(native.unitSystem));
+    ToProto(native, &result);
     return result;
 }
 
+void ToProto(const UnitSystem& native, UnitSystem* out) {
+    out->Clear();
+    out->set_unit_system(ToProto(native.unitSystem));
+}
+
 Unit ToNative(const UnitSystem_Unit proto) {
     switch (proto) {
         case UnitSystem_Unit::kMetric: return Unit::KMETRIC;
@@ -129,18 +209,37 @@ UnitSystem_Unit ToProto(const Unit native) {
     }
 }
 
-RoundingSpecification ToNative(const RoundingSpecification proto) {
+RoundingSpecification ToNative(const RoundingSpecification& proto) {
     RoundingSpecification result;
-    result.roundingSpecification = ToNative(proto.rounding_specification());
+    ToNative(proto, &result);
     return result;
 }
 
+void ToNative(const RoundingSpecification& proto, RoundingSpecification* out) {
+    out->roundingSpecification = ToNative(proto.rounding_specification());
+}
+
+RoundingSpecification ToNative(RoundingSpecification&& proto) {
+    RoundingSpecification result;
+    ToNative(std::move(proto), &result);
+    return result;
+}
+
+void ToNative(RoundingSpecification&& proto, RoundingSpecification* out) {
+    out->roundingSpecification = ToNative(proto.rounding_specification());
+}
+
 RoundingSpecification ToProto(const RoundingSpecification& native) {
     RoundingSpecification result;
-    result.set_rounding_specification(ToProto(native.roundingSpecification));
+    ToProto(native, &result);
     return result;
 }
 
+void ToProto(const RoundingSpecification& native, RoundingSpecification* out) {
+    out->Clear();
+    out->set_rounding_specification(ToProto(native.roundingSpecification));
+}
+
 Specification ToNative(const RoundingSpecification_Specification proto) {
     switch (proto) {
         case RoundingSpecification_Specification::kDefault: return Specification::KDEFAULT;
@@ -157,57 +256,115 @@ RoundingSpecification_Specification ToProto(const Specification native) {
     }
 }
 
-WarningData ToNative(const WarningData proto) {
+WarningData ToNative(const WarningData& proto) {
     WarningData result;
+    ToNative(proto, &result);
+    return result;
+}
+
+void ToNative(const WarningData& proto, WarningData* out) {
+    out->WarningDataVariant_case = {};
+    out->dynamicRouteGuidanceData = {};
+    out->ChargingStopData = {};
+    out->trafficEventData = {};
     switch (proto.WarningDataVariant_case()) {
-        case WarningData::kDynamicRouteGuidanceData: result.dynamicRouteGuidanceData = proto.dynamicRouteGuidanceData(); break;
-        case WarningData::kChargingStopData: result.ChargingStopData = proto.ChargingStopData(); break;
-        case WarningData::kTrafficEventData: result.trafficEventData = proto.trafficEventData(); break;
+        case WarningData::kDynamicRouteGuidanceData: ToNative(proto.dynamicRouteGuidanceData(), &out->dynamicRouteGuidanceData); out->WarningDataVariant_case = WarningData::kDynamicRouteGuidanceData; break;
+        case WarningData::kChargingStopData: ToNative(proto.ChargingStopData(), &out->ChargingStopData); out->WarningDataVariant_case = WarningData::kChargingStopData; break;
+        case WarningData::kTrafficEventData: ToNative(proto.trafficEventData(), &out->trafficEventData); out->WarningDataVariant_case = WarningData::kTrafficEventData; break;
         default: break;
     }
+}
+
+WarningData ToNative(WarningData&& proto) {
+    WarningData result;
+    ToNative(std::move(proto), &result);
     return result;
 }
 
+void ToNative(WarningData&& proto, WarningData* out) {
+    out->WarningDataVariant_case = {};
+    out->dynamicRouteGuidanceData = {};
+    out->ChargingStopData = {};
+    out->trafficEventData = {};
+    switch (proto.WarningDataVariant_case()) {
+        case WarningData::kDynamicRouteGuidanceData: ToNative(std::move(*proto.mutable_dynamicRouteGuidanceData()), &out->dynamicRouteGuidanceData); out->WarningDataVariant_case = WarningData::kDynamicRouteGuidanceData; break;
+        case WarningData::kChargingStopData: ToNative(std::move(*proto.mutable_ChargingStopData()), &out->ChargingStopData); out->WarningDataVariant_case = WarningData::kChargingStopData; break;
+        case WarningData::kTrafficEventData: ToNative(std::move(*proto.mutable_trafficEventData()), &out->trafficEventData); out->WarningDataVariant_case = WarningData::kTrafficEventData; break;
+        default: break;
+    }
+}
+
 WarningData ToProto(const WarningData& native) {
     WarningData result;
+    ToProto(native, &result);
+    return result;
+}
+
+void ToProto(const WarningData& native, WarningData* out) {
+    out->Clear();
     if (native.WarningDataVariant_case == WarningData::kDynamicRouteGuidanceData) {
-        result.set_dynamicRouteGuidanceData(native.dynamicRouteGuidanceData);
+        ToProto(native.dynamicRouteGuidanceData, out->mutable_dynamicRouteGuidanceData());
     }
     if (native.WarningDataVariant_case == WarningData::kChargingStopData) {
-        result.set_ChargingStopData(native.ChargingStopData);
+        ToProto(native.ChargingStopData, out->mutable_ChargingStopData());
     }
     if (native.WarningDataVariant_case == WarningData::kTrafficEventData) {
-        result.set_trafficEventData(native.trafficEventData);
+        ToProto(native.trafficEventData, out->mutable_trafficEventData());
     }
+}
+
+DynamicRouteGuidanceData ToNative(const DynamicRouteGuidanceData& proto) {
+    DynamicRouteGuidanceData result;
+    ToNative(proto, &result);
     return result;
 }
 
-DynamicRouteGuidanceData ToNative(const DynamicRouteGuidanceData proto) {
+void ToNative(const DynamicRouteGuidanceData& proto, DynamicRouteGuidanceData* out) {
+    out->reason = ToNative(proto.reason());
+    out->mode = ToNative(proto.mode());
+    out->travelTimeAdvantageSeconds = proto.travel_time_advantage_seconds();
+    out->travelDelaySeconds = proto.travel_delay_seconds();
+    out->estimatedTravelDurationSeconds = proto.estimated_travel_duration_seconds();
+    out->isChargingPlanModified = proto.is_charging_plan_modified();
+    if (proto.has_current_time_milliseconds()) { out->currentTimeMilliseconds = proto.current_time_milliseconds(); } else { out->currentTimeMilliseconds.reset(); }
+    out->warningMessageType = ToNative(proto.warning_message_type());
+}
+
+DynamicRouteGuidanceData ToNative(DynamicRouteGuidanceData&& proto) {
     DynamicRouteGuidanceData result;
-    result.reason = ToNative(proto.reason());
-    result.mode = ToNative(proto.mode());
-    result.travelTimeAdvantageSeconds = proto.travel_time_advantage_seconds();
-    result.travelDelaySeconds = proto.travel_delay_seconds();
-    result.estimatedTravelDurationSeconds = proto.estimated_travel_duration_seconds();
-    result.isChargingPlanModified = proto.is_charging_plan_modified();
-    if (proto.has_current_time_milliseconds()) { result.currentTimeMilliseconds = proto.current_time_milliseconds(); }
-    result.warningMessageType = ToNative(proto.warning_message_type());
+    ToNative(std::move(proto), &result);
     return result;
 }
 
+void ToNative(DynamicRouteGuidanceData&& proto, DynamicRouteGuidanceData* out) {
+    out->reason = ToNative(proto.reason());
+    out->mode = ToNative(proto.mode());
+    out->travelTimeAdvantageSeconds = proto.travel_time_advantage_seconds();
+    out->travelDelaySeconds = proto.travel_delay_seconds();
+    out->estimatedTravelDurationSeconds = proto.estimated_travel_duration_seconds();
+    out->isChargingPlanModified = proto.is_charging_plan_modified();
+    if (proto.has_current_time_milliseconds()) { out->currentTimeMilliseconds = proto.current_time_milliseconds(); } else { out->currentTimeMilliseconds.reset(); }
+    out->warningMessageType = ToNative(proto.warning_message_type());
+}
+
 DynamicRouteGuidanceData ToProto(const DynamicRouteGuidanceData& native) {
     DynamicRouteGuidanceData result;
-    result.set_reason(ToProto(native.reason));
-    result.set_mode(ToProto(native.mode));
-    result.set_travel_time_advantage_seconds(native.travelTimeAdvantageSeconds);
-    result.set_travel_delay_seconds(native.travelDelaySeconds);
-    result.set_estimated_travel_duration_seconds(native.estimatedTravelDurationSeconds);
-    result.set_is_charging_plan_modified(native.isChargingPlanModified);
-    if (native.currentTimeMilliseconds.has_value()) { result.set_current_time_milliseconds(native.currentTimeMilliseconds.value()); }
-    result.set_warning_message_type(ToProto(native.warningMessageType));
+    ToProto(native, &result);
     return result;
 }
 
+void ToProto(const DynamicRouteGuidanceData& native, DynamicRouteGuidanceData* out) {
+    out->Clear();
+    out->set_reason(ToProto(native.reason));
+    out->set_mode(ToProto(native.mode));
+    out->set_travel_time_advantage_seconds(native.travelTimeAdvantageSeconds);
+    out->set_travel_delay_seconds(native.travelDelaySeconds);
+    out->set_estimated_travel_duration_seconds(native.estimatedTravelDurationSeconds);
+    out->set_is_charging_plan_modified(native.isChargingPlanModified);
+    if (native.currentTimeMilliseconds.has_value()) { out->set_current_time_milliseconds(native.currentTimeMilliseconds.value()); }
+    out->set_warning_message_type(ToProto(native.warningMessageType));
+}
+
 Reason ToNative(const DynamicRouteGuidanceData_Reason proto) {
     switch (proto) {
         case DynamicRouteGuidanceData_Reason::kRouteBlockage: return Reason::KROUTEBLOCKAGE;
@@ -272,24 +429,46 @@ DynamicRouteGuidanceData_WarningMessageType ToProto(const WarningMessageType nat
     }
 }
 
-ChargingStopData ToNative(const ChargingStopData proto) {
+ChargingStopData ToNative(const ChargingStopData& proto) {
+    ChargingStopData result;
+    ToNative(proto, &result);
+    return result;
+}
+
+void ToNative(const ChargingStopData& proto, ChargingStopData* out) {
+    out->type = ToNative(proto.type());
+    out->chargerType = ToNative(proto.charger_type());
+    ToNative(proto.charger_operator_name(), &out->chargerOperatorName);
+    ToNative(proto.location_name(), &out->locationName);
+}
+
+ChargingStopData ToNative(ChargingStopData&& proto) {
     ChargingStopData result;
-    result.type = ToNative(proto.type());
-    result.chargerType = ToNative(proto.charger_type());
-    result.chargerOperatorName = ToNative(proto.charger_operator_name());
-    result.locationName = ToNative(proto.location_name());
+    ToNative(std::move(proto), &result);
     return result;
 }
 
+void ToNative(ChargingStopData&& proto, ChargingStopData* out) {
+    out->type = ToNative(proto.type());
+    out->chargerType = ToNative(proto.charger_type());
+    if (proto.has_charger_operator_name()) { ToNative(std::move(*proto.mutable_charger_operator_name()), &out->chargerOperatorName); } else { ToNative(proto.charger_operator_name(), &out->chargerOperatorName); }
+    if (proto.has_location_name()) { ToNative(std::move(*proto.mutable_location_name()), &out->locationName); } else { ToNative(proto.location_name(), &out->locationName); }
+}
+
 ChargingStopData ToProto(const ChargingStopData& native) {
     ChargingStopData result;
-    result.set_type(ToProto(native.type));
-    result.set_charger_type(ToProto(native.chargerType));
-    result.mutable_charger_operator_name()->CopyFrom(ToProto(native.chargerOperatorName));
-    result.mutable_location_name()->CopyFrom(ToProto(native.locationName));
+    ToProto(native, &result);
     return result;
 }
 
+void ToProto(const ChargingStopData& native, ChargingStopData* out) {
+    out->Clear();
+    out->set_type(ToProto(native.type));
+    out->set_charger_type(ToProto(native.chargerType));
+    ToProto(native.chargerOperatorName, out->mutable_charger_operator_name());
+    ToProto(native.locationName, out->mutable_location_name());
+}
+
 Type ToNative(const ChargingStopData_Type proto) {
     switch (proto) {
         case ChargingStopData_Type::NEXT_CHARGING_STOP_REPLACED: return Type::NEXT_CHARGING_STOP_REPLACED;
@@ -328,32 +507,58 @@ ChargingStopData_ChargerType ToProto(const ChargerType native) {
     }
 }
 
-TrafficEventData ToNative(const TrafficEventData proto) {
+TrafficEventData ToNative(const TrafficEventData& proto) {
     TrafficEventData result;
-    result.trafficEventType = ToNative(proto.traffic_event_type());
-    result.roadNumber = ToNative(proto.road_number());
-    result.roadName = ToNative(proto.road_name());
-    result.startRoadName = ToNative(proto.start_road_name());
-    result.endRoadName = ToNative(proto.end_road_name());
-    result.startExitNumber = ToNative(proto.start_exit_number());
-    result.endExitNumber = ToNative(proto.end_exit_number());
-    if (proto.has_travel_delay_seconds()) { result.travelDelaySeconds = proto.travel_delay_seconds(); }
+    ToNative(proto, &result);
     return result;
 }
 
+void ToNative(const TrafficEventData& proto, TrafficEventData* out) {
+    out->trafficEventType = ToNative(proto.traffic_event_type());
+    ToNative(proto.road_number(), &out->roadNumber);
+    ToNative(proto.road_name(), &out->roadName);
+    ToNative(proto.start_road_name(), &out->startRoadName);
+    ToNative(proto.end_road_name(), &out->endRoadName);
+    ToNative(proto.start_exit_number(), &out->startExitNumber);
+    ToNative(proto.end_exit_number(), &out->endExitNumber);
+    if (proto.has_travel_delay_seconds()) { out->travelDelaySeconds = proto.travel_delay_seconds(); } else { out->travelDelaySeconds.reset(); }
+}
+
+TrafficEventData ToNative(TrafficEventData&& proto) {
+    TrafficEventData result;
+    ToNative(std::move(proto), &result);
+    return result;
+}
+
+void ToNative(TrafficEventData&& proto, TrafficEventData* out) {
+    out->trafficEventType = ToNative(proto.traffic_event_type());
+    if (proto.has_road_number()) { ToNative(std::move(*proto.mutable_road_number()), &out->roadNumber); } else { ToNative(proto.road_number(), &out->roadNumber); }
+    if (proto.has_road_name()) { ToNative(std::move(*proto.mutable_road_name()), &out->roadName); } else { ToNative(proto.road_name(), &out->roadName); }
+    if (proto.has_start_road_name()) { ToNative(std::move(*proto.mutable_start_road_name()), &out->startRoadName); } else { ToNative(proto.start_road_name(), &out->startRoadName); }
+    if (proto.has_end_road_name()) { ToNative(std::move(*proto.mutable_end_road_name()), &out->endRoadName); } else { ToNative(proto.end_road_name(), &out->endRoadName); }
+    if (proto.has_start_exit_number()) { ToNative(std::move(*proto.mutable_start_exit_number()), &out->startExitNumber); } else { ToNative(proto.start_exit_number(), &out->startExitNumber); }
+    if (proto.has_end_exit_number()) { ToNative(std::move(*proto.mutable_end_exit_number()), &out->endExitNumber); } else { ToNative(proto.end_exit_number(), &out->endExitNumber); }
+    if (proto.has_travel_delay_seconds()) { out->travelDelaySeconds = proto.travel_delay_seconds(); } else { out->travelDelaySeconds.reset(); }
+}
+
 TrafficEventData ToProto(const TrafficEventData& native) {
     TrafficEventData result;
-    result.set_traffic_event_type(ToProto(native.trafficEventType));
-    result.mutable_road_number()->CopyFrom(ToProto(native.roadNumber));
-    result.mutable_road_name()->CopyFrom(ToProto(native.roadName));
-    result.mutable_start_road_name()->CopyFrom(ToProto(native.startRoadName));
-    result.mutable_end_road_name()->CopyFrom(ToProto(native.endRoadName));
-    result.mutable_start_exit_number()->CopyFrom(ToProto(native.startExitNumber));
-    result.mutable_end_exit_number()->CopyFrom(ToProto(native.endExitNumber));
-    if (native.travelDelaySeconds.has_value()) { result.set_travel_delay_seconds(native.travelDelaySeconds.value()); }
+    ToProto(native, &result);
     return result;
 }
 
+void ToProto(const TrafficEventData& native, TrafficEventData* out) {
+    out->Clear();
+    out->set_traffic_event_type(ToProto(native.trafficEventType));
+    ToProto(native.roadNumber, out->mutable_road_number());
+    ToProto(native.roadName, out->mutable_road_name());
+    ToProto(native.startRoadName, out->mutable_start_road_name());
+    ToProto(native.endRoadName, out->mutable_end_road_name());
+    ToProto(native.startExitNumber, out->mutable_start_exit_number());
+    ToProto(native.endExitNumber, out->mutable_end_exit_number());
+    if (native.travelDelaySeconds.has_value()) { out->set_travel_delay_seconds(native.travelDelaySeconds.value()); }
+}
+
 TrafficEventType ToNative(const TrafficEventData_TrafficEventType proto) {
     switch (proto) {
         case TrafficEventData_TrafficEventType::UNKNOWN: return TrafficEventType::UNKNOWN;
@@ -15,6 +15,7 @@
 #define PROTOBUF_HELPERS_HPP
 
 #include <string>
+#include <utility>
 #include <vector>
 
 // Forward declarations
@@ -31,48 +32,76 @@ struct TrafficEventData;
 namespace protobuf_helpers {
 
 // Conversion functions for AudioMessage
-AudioMessage ToNative(const AudioMessage proto);
+AudioMessage ToNative(const AudioMessage& proto);
+void ToNative(const AudioMessage& proto, AudioMessage* out);
+AudioMessage ToNative(AudioMessage&& proto);
+void ToNative(AudioMessage&& proto, AudioMessage* out);
 AudioMessage ToProto(const AudioMessage& native);
+void ToProto(const AudioMessage& native, AudioMessage* out);
 
 // Conversion functions for AnnouncementData
-AnnouncementData ToNative(const AnnouncementData proto);
+AnnouncementData ToNative(const AnnouncementData& proto);
+void ToNative(const AnnouncementData& proto, AnnouncementData* out);
+AnnouncementData ToNative(AnnouncementData&& proto);
+void ToNative(AnnouncementData&& proto, AnnouncementData* out);
 AnnouncementData ToProto(const AnnouncementData& native);
+void ToProto(const AnnouncementData& native, AnnouncementData* out);
 
 // Conversion functions for MessageType
 MessageType ToNative(const AnnouncementData_MessageType proto);
 AnnouncementData_MessageType ToProto(const MessageType native);
 
 // Conversion functions for VerbosityLevel
-VerbosityLevel ToNative(const VerbosityLevel proto);
+VerbosityLevel ToNative(const VerbosityLevel& proto);
+void ToNative(const VerbosityLevel& proto, VerbosityLevel* out);
+VerbosityLevel ToNative(VerbosityLevel&& proto);
+void ToNative(VerbosityLevel&& proto, VerbosityLevel* out);
 VerbosityLevel ToProto(const VerbosityLevel& native);
+void ToProto(const VerbosityLevel& native, VerbosityLevel* out);
 
 // Conversion functions for Verbosity
 Verbosity ToNative(const VerbosityLevel_Verbosity proto);
 VerbosityLevel_Verbosity ToProto(const Verbosity native);
 
 // Conversion functions for UnitSystem
-UnitSystem ToNative(const UnitSystem proto);
+UnitSystem ToNative(const UnitSystem& proto);
+void ToNative(const UnitSystem& proto, UnitSystem* out);
+UnitSystem ToNative(UnitSystem&& proto);
+void ToNative(UnitSystem&& proto, UnitSystem* out);
 UnitSystem ToProto(const UnitSystem& native);
+void ToProto(const UnitSystem& native, UnitSystem* out);
 
 // Conversion functions for Unit
 Unit ToNative(const UnitSystem_Unit proto);
 UnitSystem_Unit ToProto(const Unit native);
 
 // Conversion functions for RoundingSpecification
-RoundingSpecification ToNative(const RoundingSpecification proto);
+RoundingSpecification ToNative(const RoundingSpecification& proto);
+void ToNative(const RoundingSpecification& proto, RoundingSpecification* out);
+RoundingSpecification ToNative(RoundingSpecification&& proto);
+void ToNative(RoundingSpecification&& proto, RoundingSpecification* out);
 RoundingSpecification ToProto(const RoundingSpecification& native);
+void ToProto(const RoundingSpecification& native, RoundingSpecification* out);
 
 // Conversion functions for Specification
 Specification ToNative(const RoundingSpecification_Specification proto);
 RoundingSpecification_Specification ToProto(const Specification native);
 
 // Conversion functions for WarningData
-WarningData ToNative(const WarningData proto);
+WarningData ToNative(const WarningData& proto);
+void ToNative(const WarningData& proto, WarningData* out);
+WarningData ToNative(WarningData&& proto);
+void ToNative(WarningData&& proto, WarningData* out);
 WarningData ToProto(const WarningData& native);
+void ToProto(const WarningData& native, WarningData* out);
 
 // Conversion functions for DynamicRouteGuidanceData
-DynamicRouteGuidanceData ToNative(const DynamicRouteGuidanceData proto);
+DynamicRouteGuidanceData ToNative(const DynamicRouteGuidanceData& proto);
+void ToNative(const DynamicRouteGuidanceData& proto, DynamicRouteGuidanceData* out);
+DynamicRouteGuidanceData ToNative(DynamicRouteGuidanceData&& proto);
+void ToNative(DynamicRouteGuidanceData&& proto, DynamicRouteGuidanceData* out);
 DynamicRouteGuidanceData ToProto(const DynamicRouteGuidanceData& native);
+void ToProto(const DynamicRouteGuidanceData& native, DynamicRouteGuidanceData* out);
 
 // Conversion functions for Reason
 Reason ToNative(const DynamicRouteGuidanceData_Reason proto);
@@ -87,8 +116,12 @@ WarningMessageType ToNative(const DynamicRouteGuidanceData_WarningMessageType pr
 DynamicRouteGuidanceData_WarningMessageType ToProto(const WarningMessageType native);
 
 // Conversion functions for ChargingStopData
-ChargingStopData ToNative(const ChargingStopData proto);
+ChargingStopData ToNative(const ChargingStopData& proto);
+void ToNative(const ChargingStopData& proto, ChargingStopData* out);
+ChargingStopData ToNative(ChargingStopData&& proto);
+void ToNative(ChargingStopData&& proto, ChargingStopData* out);
 ChargingStopData ToProto(const ChargingStopData& native);
+void ToProto(const ChargingStopData& native, ChargingStopData* out);
 
 // Conversion functions for Type
 Type ToNative(const ChargingStopData_Type proto);
@@ -99,8 +132,12 @@ ChargerType ToNative(const ChargingStopData_ChargerType proto);
 ChargingStopData_ChargerType ToProto(const ChargerType native);
 
 // Conversion functions for TrafficEventData
-TrafficEventData ToNative(const TrafficEventData proto);
+TrafficEventData ToNative(const TrafficEventData& proto);
+void ToNative(const TrafficEventData& proto, TrafficEventData* out);
+TrafficEventData ToNative(TrafficEventData&& proto);
+void ToNative(TrafficEventData&& proto, TrafficEventData* out);
 TrafficEventData ToProto(const TrafficEventData& native);
+void ToProto(const TrafficEventData& native, TrafficEventData* out);
 
 // Conversion functions for TrafficEventType
 TrafficEventType ToNative(const TrafficEventData_TrafficEventType proto);